@@ -0,0 +1,69 @@
+#include "accumulator.h"
+
+big_integer_accumulator::big_integer_accumulator() : pending_(0) {}
+
+big_integer_accumulator &big_integer_accumulator::operator+=(big_integer const &a) {
+  add_limbs_(a.sign_ ? negative_ : positive_, a);
+  return *this;
+}
+
+big_integer_accumulator &big_integer_accumulator::operator-=(big_integer const &a) {
+  add_limbs_(a.sign_ ? positive_ : negative_, a);
+  return *this;
+}
+
+big_integer big_integer_accumulator::value() const {
+  return to_big_integer_(positive_) - to_big_integer_(negative_);
+}
+
+void big_integer_accumulator::clear() {
+  positive_.clear();
+  negative_.clear();
+  pending_ = 0;
+}
+
+void big_integer_accumulator::add_limbs_(std::vector<uint64_t> &sums, big_integer const &a) {
+  // A sum is at most (2^32 - 1) * (pending_ + 1), so it cannot overflow within max_pending additions
+  if (pending_ == max_pending) {
+    propagate_(positive_);
+    propagate_(negative_);
+    pending_ = 0;
+  }
+  ++pending_;
+  size_t const n = a.size();
+  if (sums.size() < n) {
+    sums.resize(n);
+  }
+  uint32_t const *b = a.value_.data();
+  uint64_t *s = sums.data();
+  for (size_t i = 0; i < n; ++i) {
+    s[i] += b[i];
+  }
+}
+
+void big_integer_accumulator::propagate_(std::vector<uint64_t> &sums) {
+  uint64_t carry = 0;
+  for (uint64_t &sum : sums) {
+    // sum <= 2^64 - 2^32 and carry < 2^32, so the addition does not wrap
+    sum += carry;
+    carry = sum >> 32u;
+    sum &= UINT32_MAX;
+  }
+  for (; carry != 0; carry >>= 32u) {
+    sums.push_back(carry & UINT32_MAX);
+  }
+}
+
+big_integer big_integer_accumulator::to_big_integer_(std::vector<uint64_t> sums) {
+  propagate_(sums);
+  if (sums.empty()) {
+    return big_integer();
+  }
+  big_integer res(false, sums.size());
+  uint32_t *r = res.value_.data();
+  for (size_t i = 0; i < sums.size(); ++i) {
+    r[i] = static_cast<uint32_t>(sums[i]);
+  }
+  res.to_normal_form();
+  return res;
+}
@@ -0,0 +1,32 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_ACCUMULATOR_H_
+#define BIGINT_BIGINT_OPTIMIZED_ACCUMULATOR_H_
+
+#include <cstdint>
+#include <vector>
+#include "big_integer.h"
+
+// Sum of many big_integers kept as per-limb 64-bit sums.
+// Adding a value is one pass over its limbs with no carry chain; carries are propagated when the sum is read.
+struct big_integer_accumulator {
+  big_integer_accumulator();
+
+  big_integer_accumulator &operator+=(big_integer const &a);
+  big_integer_accumulator &operator-=(big_integer const &a);
+
+  big_integer value() const;
+  void clear();
+
+ private:
+  // Values added to each set of sums since their carries were last propagated
+  static uint64_t const max_pending = UINT32_MAX;
+
+  std::vector<uint64_t> positive_;
+  std::vector<uint64_t> negative_;
+  uint64_t pending_;
+
+  void add_limbs_(std::vector<uint64_t> &sums, big_integer const &a);
+  static void propagate_(std::vector<uint64_t> &sums);
+  static big_integer to_big_integer_(std::vector<uint64_t> sums);
+};
+
+#endif // BIGINT_BIGINT_OPTIMIZED_ACCUMULATOR_H_
@@ -0,0 +1,194 @@
+#include "arena_storage.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace {
+
+// Blocks hold 1 << k limbs, k >= min_class; a fresh chunk holds chunk_limbs limbs or one larger block
+unsigned const min_class = 2;
+size_t const chunk_limbs = size_t(1) << 18u;
+
+struct alignas(16) chunk_header {
+  chunk_header *next;
+};
+
+struct free_block {
+  free_block *next;
+};
+
+// Every chunk stays linked here, so the memory is never lost, only reused
+std::mutex chunks_mutex;
+chunk_header *chunks = nullptr;
+
+// Plain data, zero-initialized per thread without a constructor
+struct arena {
+  uint32_t *cur;
+  uint32_t *end;
+  free_block *free_lists[64];
+};
+
+thread_local arena local_arena;
+
+unsigned size_class(size_t limbs) {
+  return limbs <= (size_t(1) << min_class) ? min_class
+                                            : 64u - static_cast<unsigned>(__builtin_clzll(limbs - 1));
+}
+
+uint32_t *new_chunk(size_t limbs) {
+  chunk_header *c = static_cast<chunk_header *>(::operator new(sizeof(chunk_header) + limbs * sizeof(uint32_t)));
+  std::lock_guard<std::mutex> lock(chunks_mutex);
+  c->next = chunks;
+  chunks = c;
+  return reinterpret_cast<uint32_t *>(c + 1);
+}
+
+uint32_t *allocate(unsigned k) {
+  arena &a = local_arena;
+  if (a.free_lists[k] != nullptr) {
+    free_block *b = a.free_lists[k];
+    a.free_lists[k] = b->next;
+    return reinterpret_cast<uint32_t *>(b);
+  }
+  size_t const limbs = size_t(1) << k;
+  if (static_cast<size_t>(a.end - a.cur) < limbs) {
+    size_t const n = std::max(chunk_limbs, limbs);
+    a.cur = new_chunk(n);
+    a.end = a.cur + n;
+  }
+  uint32_t *p = a.cur;
+  a.cur += limbs;
+  return p;
+}
+
+void release(uint32_t *p, size_t capacity) {
+  arena &a = local_arena;
+  unsigned const k = size_class(capacity);
+  a.free_lists[k] = new (p) free_block{a.free_lists[k]};
+}
+
+}
+
+arena_storage::arena_storage(size_t size, uint32_t val)
+    : size_(size), capacity_(size_t(1) << size_class(size)), data_(allocate(size_class(size))) {
+  std::fill(data_, data_ + size_, val);
+}
+
+arena_storage::arena_storage(arena_storage const &other)
+    : size_(other.size_), capacity_(size_t(1) << size_class(other.size_)), data_(allocate(size_class(other.size_))) {
+  std::copy(other.data_, other.data_ + size_, data_);
+}
+
+arena_storage::arena_storage(arena_storage &&other) noexcept
+    : size_(other.size_), capacity_(other.capacity_), data_(other.data_) {
+  other.size_ = 0;
+  other.capacity_ = 0;
+  other.data_ = nullptr;
+}
+
+arena_storage::~arena_storage() {
+  if (data_ != nullptr) {
+    release(data_, capacity_);
+  }
+}
+
+uint32_t &arena_storage::operator[](size_t index) {
+  return data_[index];
+}
+
+uint32_t const &arena_storage::operator[](size_t index) const {
+  return data_[index];
+}
+
+uint32_t const &arena_storage::back() const {
+  return data_[size_ - 1];
+}
+
+uint32_t *arena_storage::data() {
+  return data_;
+}
+
+uint32_t const *arena_storage::data() const {
+  return data_;
+}
+
+arena_storage &arena_storage::operator=(arena_storage const &other) {
+  if (this != &other) {
+    if (other.size_ > capacity_) {
+      uint32_t *p = allocate(size_class(other.size_));
+      if (data_ != nullptr) {
+        release(data_, capacity_);
+      }
+      data_ = p;
+      capacity_ = size_t(1) << size_class(other.size_);
+    }
+    size_ = other.size_;
+    std::copy(other.data_, other.data_ + size_, data_);
+  }
+  return *this;
+}
+
+arena_storage &arena_storage::operator=(arena_storage &&other) noexcept {
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(data_, other.data_);
+  return *this;
+}
+
+void arena_storage::resize(size_t new_size, uint32_t val) {
+  reserve(new_size);
+  if (size_ < new_size) {
+    std::fill(data_ + size_, data_ + new_size, val);
+  }
+  size_ = new_size;
+}
+
+void arena_storage::push_back(uint32_t val) {
+  reserve(size_ + 1);
+  data_[size_++] = val;
+}
+
+void arena_storage::pop_back() {
+  --size_;
+}
+
+void arena_storage::clear() {
+  size_ = 0;
+}
+
+void arena_storage::reserve(size_t new_capacity) {
+  if (new_capacity > capacity_) {
+    grow(new_capacity);
+  }
+}
+
+size_t arena_storage::size() const {
+  return size_;
+}
+
+size_t arena_storage::capacity() const {
+  return capacity_;
+}
+
+bool arena_storage::exclusive() const {
+  return true;
+}
+
+void arena_storage::make_thread_safe() {}
+
+bool arena_storage::operator==(arena_storage const &other) const {
+  return size_ == other.size_ && std::equal(data_, data_ + size_, other.data_);
+}
+
+void arena_storage::grow(size_t new_capacity) {
+  unsigned const k = size_class(new_capacity);
+  uint32_t *p = allocate(k);
+  if (data_ != nullptr) {
+    std::copy(data_, data_ + size_, p);
+    release(data_, capacity_);
+  }
+  data_ = p;
+  capacity_ = size_t(1) << k;
+}
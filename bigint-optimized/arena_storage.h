@@ -0,0 +1,49 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_ARENA_STORAGE_H_
+#define BIGINT_BIGINT_OPTIMIZED_ARENA_STORAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Limbs in power-of-two blocks cut from large chunks of a per-thread arena, never shared.
+// A freed block goes to the free list of its size in the freeing thread and is reused from there,
+// so steady-state arithmetic does not reach the system allocator. Chunks are kept until the process exits.
+struct arena_storage {
+  explicit arena_storage(size_t size, uint32_t val = 0);
+  arena_storage(arena_storage const& other);
+  arena_storage(arena_storage&& other) noexcept;
+
+  ~arena_storage();
+
+  uint32_t& operator[](size_t index);
+  uint32_t const& operator[](size_t index) const;
+  uint32_t const& back() const;
+
+  uint32_t* data();
+  uint32_t const* data() const;
+
+  arena_storage& operator=(arena_storage const& other);
+  arena_storage& operator=(arena_storage&& other) noexcept;
+
+  void resize(size_t new_size, uint32_t c = 0);
+  void push_back(uint32_t val);
+  void pop_back();
+  void clear();
+  void reserve(size_t new_capacity);
+
+  size_t size() const;
+  size_t capacity() const;
+
+  bool exclusive() const;
+  void make_thread_safe();
+
+  bool operator==(arena_storage const& other) const;
+
+ private:
+  void grow(size_t new_capacity);
+
+  size_t size_;
+  size_t capacity_;
+  uint32_t* data_;
+};
+
+#endif //BIGINT_BIGINT_OPTIMIZED_ARENA_STORAGE_H_
@@ -0,0 +1,33 @@
+#include "barrett.h"
+
+barrett_context::barrett_context(big_integer const &m) : m_(m), k_(m.size()) {
+  if (m.sign_ || m.is_zero()) {
+    throw std::runtime_error("barrett modulus must be positive");
+  }
+  mu_ = (big_integer(1) << static_cast<int>(64 * k_)) / m_;
+}
+
+big_integer const &barrett_context::modulus() const {
+  return m_;
+}
+
+big_integer barrett_context::reduce(big_integer const &a) const {
+  if (a.sign_ || a.size() > 2 * k_) {
+    big_integer r = a % m_;
+    return r.sign_ ? r += m_ : r;
+  }
+  if (a.size() < k_) {
+    return a < m_ ? a : a - m_;
+  }
+  // q underestimates floor(a / m) by at most 2
+  big_integer q = ((a >> static_cast<int>(32 * (k_ - 1))) * mu_) >>= static_cast<int>(32 * (k_ + 1));
+  big_integer r = a - (q *= m_);
+  while (r >= m_) {
+    r -= m_;
+  }
+  return r;
+}
+
+big_integer barrett_context::multiply(big_integer const &a, big_integer const &b) const {
+  return reduce(a * b);
+}
@@ -0,0 +1,26 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_BARRETT_H_
+#define BIGINT_BIGINT_OPTIMIZED_BARRETT_H_
+
+#include <cstddef>
+#include "big_integer.h"
+
+// Reduction modulo a fixed m > 0 of k limbs, m need not be odd. mu = floor(B^2k / m) is computed once, then
+// a in [0, B^2k) is reduced with two multiplications and at most two subtractions of m.
+struct barrett_context {
+  // Throws std::runtime_error unless m is positive
+  explicit barrett_context(big_integer const &m);
+
+  big_integer const &modulus() const;
+
+  // a mod m in [0, m) for any a; outside [0, B^2k) this falls back to operator%
+  big_integer reduce(big_integer const &a) const;
+  // a * b mod m for a, b in [0, m)
+  big_integer multiply(big_integer const &a, big_integer const &b) const;
+
+ private:
+  big_integer m_;
+  size_t k_;
+  big_integer mu_;
+};
+
+#endif // BIGINT_BIGINT_OPTIMIZED_BARRETT_H_
@@ -6,6 +6,10 @@ big_integer::big_integer() : value_(1), sign_(false) {}
 
 big_integer::big_integer(big_integer const &other) = default;
 
+big_integer::big_integer(big_integer &&other) noexcept : big_integer() {
+  swap(other);
+}
+
 big_integer::big_integer(int a) : value_(1), sign_(a < 0) {
   value_[0] = static_cast<uint32_t>(a < 0 ? -static_cast<int64_t>(a) : static_cast<int64_t>(a));
 }
@@ -13,7 +17,7 @@ big_integer::big_integer(int a) : value_(1), sign_(a < 0) {
 big_integer::big_integer(uint64_t a) : value_(2), sign_(false) {
   value_[0] = static_cast<uint32_t>(a);
   value_[1] = static_cast<uint32_t>(a >> 32u);
-  to_normal_form();
+  trim_(value_[1] != 0 ? 2 : 1);
 }
 
 big_integer::big_integer(std::string const &str) : big_integer() {
@@ -22,18 +26,53 @@ big_integer::big_integer(std::string const &str) : big_integer() {
   }
   size_t i = (str[0] == '-' || str[0] == '+' ? 1 : 0);
   while (i < str.length()) {
-    this->mul_short_(10);
-    this->add_short_abs_(str[i++] - '0');
+    size_t const len = std::min<size_t>(9, str.length() - i);
+    uint32_t chunk = 0, scale = 1;
+    for (size_t j = 0; j < len; ++j) {
+      chunk = chunk * 10 + static_cast<uint32_t>(str[i++] - '0');
+      scale *= 10;
+    }
+    this->mul_short_(scale);
+    this->add_short_abs_(chunk);
   }
   sign_ = (str[0] == '-');
-  to_normal_form();
+  // the short operations keep the magnitude normal, only the sign of zero is left
+  trim_(size());
 }
 
 void big_integer::swap(big_integer &other) noexcept {
-  std::swap(value_, other.value_);
+  using std::swap;
+  swap(value_, other.value_);
   std::swap(sign_, other.sign_);
 }
 
+big_integer &big_integer::make_thread_safe() {
+  value_.make_thread_safe();
+  return *this;
+}
+
+size_t big_integer::bit_length() const {
+  uint32_t top = value_.back();
+  size_t len = 32 * (size() - 1);
+  for (; top != 0; top >>= 1u) {
+    ++len;
+  }
+  return len;
+}
+
+bool big_integer::bit(size_t i) const {
+  storage_t const &v = value_;
+  return i / 32 < size() && ((v[i / 32] >> (i % 32)) & 1u) != 0;
+}
+
+bool big_integer::divisible_by(uint32_t d) const {
+  if (d == 0) {
+    throw std::runtime_error("division by zero");
+  }
+  storage_t const &v = value_;
+  return limbs_mod_1(v.data(), size(), d) == 0;
+}
+
 big_integer &big_integer::operator=(big_integer const &other) {
   if (this != &other) {
     big_integer tmp(other);
@@ -42,23 +81,26 @@ big_integer &big_integer::operator=(big_integer const &other) {
   return *this;
 }
 
+big_integer &big_integer::operator=(big_integer &&other) noexcept {
+  // other is left as zero, the previous value is released with tmp
+  big_integer tmp(std::move(other));
+  swap(tmp);
+  return *this;
+}
 
 //---------------------------------------------Short-arithmetic-operations----------------------------------------------
 
 big_integer &big_integer::add_short_abs_(uint32_t val) {
-  big_integer res(sign_, 0);
-  res.value_.reserve(value_.size() + 1);
-  uint32_t carry = val;
-  for (size_t i = 0; i < size(); ++i) {
-    uint64_t tmp = static_cast<uint64_t>(value_[i]) + carry;
-    res.value_.push_back(static_cast<uint32_t>(tmp));
-    carry = static_cast<uint32_t>(tmp >> 32u);
+  uint32_t *r = value_.data();
+  uint64_t carry = val;
+  for (size_t i = 0; carry != 0 && i < size(); ++i) {
+    carry += r[i];
+    r[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
   }
   if (carry != 0) {
-    res.value_.push_back(carry);
+    value_.push_back(static_cast<uint32_t>(carry));
   }
-  res.to_normal_form();
-  swap(res);
   return *this;
 }
 
@@ -66,19 +108,11 @@ big_integer &big_integer::mul_short_(uint32_t val) {
   if (val == 0) {
     return *this = big_integer();
   }
-  big_integer res(sign_, 0);
-  res.value_.reserve(value_.size() + 1);
-  uint32_t carry = 0;
-  for (size_t i = 0; i < size(); ++i) {
-    uint64_t tmp = static_cast<uint64_t>(value_[i]) * val + carry;
-    res.value_.push_back(static_cast<uint32_t>(tmp));
-    carry = static_cast<uint32_t>(tmp >> 32u);
-  }
+  uint32_t *r = value_.data();
+  uint32_t const carry = limbs_mul_1(r, r, size(), val);
   if (carry != 0) {
-    res.value_.push_back(carry);
+    value_.push_back(carry);
   }
-  res.to_normal_form();
-  swap(res);
   return *this;
 }
 
@@ -89,87 +123,188 @@ uint32_t big_integer::div_short_(uint32_t val) {
   if (is_zero()) {
     return 0;
   }
-  big_integer res = *this;
-  uint32_t carry = 0;
-  for (size_t i = res.size(); i > 0; --i) {
-    uint64_t tmp = (static_cast<uint64_t>(carry) << 32u) + res.value_[i - 1];
-    res.value_[i - 1] = tmp / val;
-    carry = tmp % val;
+  size_t const n = size();
+  uint32_t *r = value_.data();
+  uint32_t const rem = limbs_divrem_1(r, r, n, val);
+  // a one-limb divisor shortens the value by at most one limb
+  trim_(n > 1 && r[n - 1] == 0 ? n - 1 : n);
+  return rem;
+}
+
+//--------------------------------------------Operations-with-native-integers-------------------------------------------
+
+big_integer &big_integer::add_native_(bool sign, uint64_t magnitude) {
+  if (is_word()) {
+    return add_word_(sign, magnitude);
   }
-  res.to_normal_form();
-  swap(res);
-  return carry;
+  uint32_t const b[2] = {static_cast<uint32_t>(magnitude), static_cast<uint32_t>(magnitude >> 32u)};
+  if (sign_ == sign) {
+    add_abs_(b, b[1] != 0 ? 2 : 1);
+  } else {
+    sub_abs_(b, b[1] != 0 ? 2 : 1);
+  }
+  return *this;
+}
+
+big_integer &big_integer::mul_native_(bool sign, uint64_t magnitude) {
+  if (is_word()) {
+    return assign_wide_(sign_ ^ sign, static_cast<uint128_t>(word()) * magnitude);
+  }
+  if (magnitude <= UINT32_MAX) {
+    mul_short_(static_cast<uint32_t>(magnitude));
+  } else {
+    uint32_t const b[2] = {static_cast<uint32_t>(magnitude), static_cast<uint32_t>(magnitude >> 32u)};
+    mul_abs_(b, 2);
+  }
+  sign_ = sign_ ^ sign;
+  return trim_(size());
+}
+
+big_integer &big_integer::div_native_(bool sign, uint64_t magnitude) {
+  if (magnitude == 0) {
+    throw std::runtime_error("division by zero");
+  }
+  if (is_word()) {
+    return assign_wide_(sign_ ^ sign, word() / magnitude);
+  }
+  if (magnitude <= UINT32_MAX) {
+    div_short_(static_cast<uint32_t>(magnitude));
+  } else {
+    size_t const n = size();
+    uint32_t *r = value_.data();
+    uint64_t rem = 0;
+    for (size_t i = n; i > 0; --i) {
+      uint128_t cur = (static_cast<uint128_t>(rem) << 32u) | r[i - 1];
+      r[i - 1] = static_cast<uint32_t>(cur / magnitude);
+      rem = static_cast<uint64_t>(cur % magnitude);
+    }
+    // dividing by two limbs shortens the value by at most two limbs
+    trim_(r[n - 1] != 0 ? n : (r[n - 2] != 0 ? n - 1 : n - 2));
+  }
+  // the quotient of three or more limbs by at most two is not zero
+  sign_ = sign_ ^ sign;
+  return *this;
+}
+
+uint64_t big_integer::mod_native_(uint64_t magnitude) const {
+  if (magnitude == 0) {
+    throw std::runtime_error("division by zero");
+  }
+  if (is_word()) {
+    return word() % magnitude;
+  }
+  uint32_t const *a = value_.data();
+  uint64_t rem = 0;
+  if (magnitude <= UINT32_MAX) {
+    rem = limbs_mod_1(a, size(), static_cast<uint32_t>(magnitude));
+  } else {
+    for (size_t i = size(); i > 0; --i) {
+      rem = static_cast<uint64_t>(((static_cast<uint128_t>(rem) << 32u) | a[i - 1]) % magnitude);
+    }
+  }
+  return rem;
+}
+
+int big_integer::compare_native_(bool sign, uint64_t magnitude) const {
+  sign = sign && magnitude != 0;
+  if (sign_ != sign) {
+    return sign_ ? -1 : 1;
+  }
+  int const abs_cmp = !is_word() ? 1 : (word() < magnitude ? -1 : (word() > magnitude ? 1 : 0));
+  return sign_ ? -abs_cmp : abs_cmp;
 }
 
 //----------------------------------------Binary-operations-with-one-argument-------------------------------------------
 
-big_integer &big_integer::operator+=(big_integer const &rhs) {
-  if (rhs.is_zero()) {
-    return *this;
+void big_integer::add_abs_(uint32_t const *b, size_t m) {
+  if (size() < m) {
+    value_.resize(m);
   }
-  if (sign_ != rhs.sign_) {
-    return *this -= -rhs;
-  }
-  big_integer res(sign_, 0);
-  res.value_.reserve(std::max(size(), rhs.size()) + 1);
-  uint64_t sum, carry = 0;
-  for (size_t i = 0; i < size(); ++i) {
-    sum = carry;
-    sum += i < size() ? value_[i] : 0;
-    sum += i < rhs.size() ? rhs.value_[i] : 0;
-    res.value_.push_back(static_cast<uint32_t>(sum));
-    carry = sum >> 32u;
+  size_t const n = size();
+  uint32_t *r = value_.data();
+  uint64_t carry = limbs_add_n(r, r, b, m);
+  for (size_t i = m; carry != 0 && i < n; ++i) {
+    carry += r[i];
+    r[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
   }
   if (carry != 0) {
-    res.value_.push_back(carry);
+    value_.push_back(static_cast<uint32_t>(carry));
+  }
+}
+
+void big_integer::sub_abs_(uint32_t const *b, size_t m) {
+  storage_t const &lhs = value_;
+  bool const reversed = compare_abs(lhs.data(), size(), b, m) < 0;
+  if (size() < m) {
+    value_.resize(m);
+  }
+  size_t const n = size();
+  uint32_t *r = value_.data();
+  if (reversed) {
+    limbs_sub_n(r, b, r, n);
+    sign_ = !sign_;
+  } else {
+    uint64_t diff, borrow = limbs_sub_n(r, r, b, m);
+    for (size_t i = m; borrow != 0 && i < n; ++i) {
+      diff = static_cast<uint64_t>(r[i]) - borrow;
+      r[i] = static_cast<uint32_t>(diff);
+      borrow = diff >> 63u;
+    }
+  }
+  to_normal_form();
+}
+
+big_integer &big_integer::operator+=(big_integer const &rhs) {
+  if (is_word() && rhs.is_word()) {
+    return add_word_(rhs.sign_, rhs.word());
+  }
+  if (sign_ == rhs.sign_) {
+    add_abs_(rhs.value_.data(), rhs.size());
+  } else {
+    sub_abs_(rhs.value_.data(), rhs.size());
   }
-  swap(res);
   return *this;
 }
 
 big_integer &big_integer::operator-=(big_integer const &rhs) {
-  if (rhs.is_zero()) {
-    return *this;
+  if (is_word() && rhs.is_word()) {
+    return add_word_(!rhs.sign_, rhs.word());
   }
   if (sign_ != rhs.sign_) {
-    return *this += -rhs;
-  }
-  if (big_integer::less_abs(*this, rhs)) {
-    swap((big_integer(rhs) -= *this).negate());
-    return *this;
+    add_abs_(rhs.value_.data(), rhs.size());
+  } else {
+    sub_abs_(rhs.value_.data(), rhs.size());
   }
-  big_integer res(sign_, 0);
-  res.value_.reserve(std::max(size(), rhs.size()));
-  uint32_t sub;
-  bool borrow = false;
-  for (size_t i = 0; i < size(); ++i) {
-    sub = value_[i] - static_cast<uint32_t>(borrow);
-    sub -= i < rhs.size() ? rhs.value_[i] : 0;
-    borrow = i < rhs.size() ? value_[i] < rhs.value_[i] + static_cast<uint64_t>(borrow) : false;
-    res.value_.push_back(sub);
-  }
-  res.to_normal_form();
-  swap(res);
   return *this;
 }
 
 big_integer &big_integer::operator*=(big_integer const &rhs) {
+  if (is_word() && rhs.is_word()) {
+    return assign_wide_(sign_ ^ rhs.sign_, static_cast<uint128_t>(word()) * rhs.word());
+  }
   if (is_zero() || rhs.is_zero()) {
     return *this = big_integer();
   }
-  big_integer res(sign_ ^ rhs.sign_, size() + rhs.size());
-  for (size_t i = 0; i < size(); ++i) {
-    uint32_t carry = 0;
-    for (size_t j = 0; j < rhs.size(); ++j) {
-      uint64_t product = static_cast<uint64_t>(value_[i]) * rhs.value_[j] + res.value_[i + j] + carry;
-      res.value_[i + j] = static_cast<uint32_t>(product);
-      carry = static_cast<uint32_t>(product >> 32u);
-    }
-    res.value_[i + rhs.size()] = carry;
+  mul_abs_(rhs.value_.data(), rhs.size());
+  sign_ = sign_ ^ rhs.sign_;
+  return *this;
+}
+
+void big_integer::mul_abs_(uint32_t const *b, size_t m) {
+  big_integer res(sign_, size() + m);
+  storage_t const &lhs = value_;
+  uint32_t const *a = lhs.data();
+  uint32_t *r = res.value_.data();
+  size_t const n = size();
+  if (a == b && n == m) {
+    limbs_sqr(r, a, n);
+  } else {
+    limbs_mul(r, a, n, b, m);
   }
-  res.to_normal_form();
+  // the product of an n-limb and an m-limb value has n + m or n + m - 1 limbs
+  res.trim_(r[n + m - 1] != 0 ? n + m : n + m - 1);
   swap(res);
-  return *this;
 }
 
 // Division
@@ -177,36 +312,18 @@ big_integer &big_integer::operator*=(big_integer const &rhs) {
 
 uint128_t const BASE = static_cast<uint128_t>(UINT32_MAX) + 1;
 
-uint32_t big_integer::trial(uint64_t const k, uint64_t const m, big_integer const &d) {
-  uint128_t r3 = (static_cast<uint128_t>(value_[k + m]) * BASE + value_[k + m - 1]) * BASE + value_[k + m - 2];
-  uint64_t const d2 = (static_cast<uint64_t>(d.value_[m - 1]) << 32u) + d.value_[m - 2];
+uint32_t big_integer::trial(uint64_t const k, uint64_t const m, big_integer const &d) const {
+  uint32_t const *r = value_.data(), *dp = d.value_.data();
+  uint128_t r3 = (static_cast<uint128_t>(r[k + m]) * BASE + r[k + m - 1]) * BASE + r[k + m - 2];
+  uint64_t const d2 = (static_cast<uint64_t>(dp[m - 1]) << 32u) + dp[m - 2];
   return static_cast<uint32_t>(std::min(r3 / d2, BASE - 1));
 }
 
-bool big_integer::smaller(big_integer const &dq, uint64_t const k, uint64_t const m) {
-  uint64_t i = m, j = 0;
-  while (i != j) {
-    if (value_[i + k] != dq.value_[i]) {
-      j = i;
-    } else {
-      --i;
-    }
-  }
-  return value_[i + k] < dq.value_[i];
-}
-
-void big_integer::difference(big_integer const &dq, uint64_t const k, uint64_t const m) {
-  uint64_t borrow = 0, diff;
-  for (size_t i = 0; i <= m; ++i) {
-    diff = static_cast<uint64_t>(value_[i + k]) - dq.value_[i] - borrow + BASE;
-    value_[i + k] = static_cast<uint32_t>(diff % BASE);
-    borrow = 1 - diff / BASE;
-  }
-}
-
 big_integer &big_integer::operator/=(big_integer const &rhs) {
   if (rhs.is_zero()) {
     throw std::runtime_error("division by zero");
+  } else if (is_word() && rhs.is_word()) {
+    return assign_wide_(sign_ ^ rhs.sign_, word() / rhs.word());
   } else if (size() < rhs.size()) {
     return *this = big_integer();
   } else if (rhs.size() == 1) {
@@ -219,106 +336,138 @@ big_integer &big_integer::operator/=(big_integer const &rhs) {
   big_integer q(sign_ ^ rhs.sign_, n - m + 1), r = *this * f, d = rhs * f;
   r.sign_ = d.sign_ = false;
   r.value_.push_back(0);
+  uint32_t *rp = r.value_.data(), *qp = q.value_.data();
+  uint32_t const *dp = d.value_.data();
   for (ptrdiff_t k = n - m; k >= 0; --k) {
     uint32_t qt = r.trial(static_cast<uint64_t>(k), m, d);
-    big_integer qt_mul = big_integer(static_cast<uint64_t>(qt));
-    big_integer dq = qt_mul * d;
-    dq.value_.resize(m + 1);
-    if (r.smaller(dq, static_cast<uint64_t>(k), m)) {
+    uint64_t const top = static_cast<uint64_t>(rp[k + m]) - limbs_submul_1(rp + k, dp, m, qt);
+    rp[k + m] = static_cast<uint32_t>(top);
+    // the trial quotient is at most one too large
+    if ((top >> 63u) != 0) {
       qt--;
-      dq = big_integer(d).mul_short_(qt);
+      rp[k + m] += limbs_add_n(rp + k, rp + k, dp, m);
     }
-    q.value_[k] = qt;
-    r.difference(dq, static_cast<uint64_t>(k), m);
+    qp[k] = qt;
   }
-  q.to_normal_form();
+  // the quotient has n - m + 1 or n - m limbs
+  q.trim_(qp[n - m] != 0 ? n - m + 1 : n - m);
   swap(q);
   return *this;
 }
 
 big_integer &big_integer::operator%=(big_integer const &rhs) {
+  if (is_word() && rhs.is_word()) {
+    if (rhs.is_zero()) {
+      throw std::runtime_error("division by zero");
+    }
+    return assign_wide_(sign_, word() % rhs.word());
+  }
   return *this -= (big_integer(*this) /= rhs) *= rhs;
 }
 
 // Bitwise operations
 
-void big_integer::to_additional_code(size_t size, big_integer const &src, big_integer &dst) {
-  dst.value_.resize(size, 0);
-  if (src.sign_) {
-    dst.sign_ = false;
-    for (size_t i = 0; i < size; ++i) {
-      dst.value_[i] = ~(i < src.size() ? src.value_[i] : 0);
-    }
-    dst += 1;
-  } else {
-    dst.sign_ = false;
-    for (size_t i = 0; i < size; ++i) {
-      dst.value_[i] = i < src.size() ? src.value_[i] : 0;
-    }
-  }
-}
-
-big_integer &big_integer::bitwise_op(uint32_t (*op)(uint32_t, uint32_t), big_integer const &rhs) {
-  bool sign = op(sign_, rhs.sign_);
-  size_t max_size = std::max(size(), rhs.size());
-  big_integer a(sign_, 0);
-  big_integer b(rhs.sign_, 0);
-  to_additional_code(max_size, *this, a);
-  to_additional_code(max_size, rhs, b);
-  for (size_t i = 0; i < a.size(); ++i) {
-    a.value_[i] = op(a.value_[i], b.value_[i]);
-  }
-  if (sign) {
-    a.negate();
-    to_additional_code(max_size, a, a);
-    a.negate();
-  }
-  a.to_normal_form();
-  swap(a);
-  return *this;
+// Both operands and the result are converted to and from two's complement on the fly: a negative magnitude m
+// is read as ~m + 1, the carry of that +1 running along the limbs. One extra limb holds the sign extension.
+// Once all carries have died out the rest is a plain masked limb loop handed to the vector kernel.
+template <typename Op>
+big_integer &big_integer::bitwise_op(Op op, limbs_bitwise_fn kernel, big_integer const &rhs) {
+  size_t const n = std::max(size(), rhs.size()) + 1, m = rhs.size();
+  bool const sign = op(sign_, rhs.sign_) != 0;
+  uint32_t const a_mask = sign_ ? UINT32_MAX : 0, b_mask = rhs.sign_ ? UINT32_MAX : 0, r_mask = sign ? UINT32_MAX : 0;
+  uint64_t a_carry = sign_ ? 1 : 0, b_carry = rhs.sign_ ? 1 : 0, r_carry = sign ? 1 : 0;
+  value_.resize(n);
+  uint32_t *r = value_.data();
+  uint32_t const *b = rhs.value_.data();
+  size_t i = 0;
+  for (; i < n && (a_carry | b_carry | r_carry) != 0; ++i) {
+    a_carry += r[i] ^ a_mask;
+    b_carry += (i < m ? b[i] : 0) ^ b_mask;
+    r_carry += op(static_cast<uint32_t>(a_carry), static_cast<uint32_t>(b_carry)) ^ r_mask;
+    r[i] = static_cast<uint32_t>(r_carry);
+    a_carry >>= 32u;
+    b_carry >>= 32u;
+    r_carry >>= 32u;
+  }
+  if (i < m) {
+    kernel(r + i, r + i, b + i, m - i, a_mask, b_mask, r_mask);
+    i = m;
+  }
+  for (; i < n; ++i) {
+    r[i] = op(r[i] ^ a_mask, b_mask) ^ r_mask;
+  }
+  sign_ = sign;
+  return to_normal_form();
 }
 
 big_integer &big_integer::operator&=(big_integer const &rhs) {
-  return big_integer::bitwise_op([](uint32_t a, uint32_t b) { return a & b; }, rhs);
+  return big_integer::bitwise_op([](uint32_t a, uint32_t b) { return a & b; }, limbs_and, rhs);
 }
 
 big_integer &big_integer::operator|=(big_integer const &rhs) {
-  return big_integer::bitwise_op([](uint32_t a, uint32_t b) { return a | b; }, rhs);
+  return big_integer::bitwise_op([](uint32_t a, uint32_t b) { return a | b; }, limbs_or, rhs);
 }
 
 big_integer &big_integer::operator^=(big_integer const &rhs) {
-  return big_integer::bitwise_op([](uint32_t a, uint32_t b) { return a ^ b; }, rhs);
+  return big_integer::bitwise_op([](uint32_t a, uint32_t b) { return a ^ b; }, limbs_xor, rhs);
 }
 
 // Shifts
 
 big_integer &big_integer::operator<<=(int shift) {
-  big_integer res(sign_, 0);
-  size_t d = static_cast<size_t>(shift / 32u);
-  for (size_t i = 0; i < d; ++i) {
-    res.value_.push_back(0);
+  if (is_zero()) {
+    return *this;
   }
-  for (size_t i = 0; i < size(); ++i) {
-    res.value_.push_back(value_[i]);
+  size_t const d = static_cast<size_t>(shift) / 32u, n = size();
+  uint32_t const b = static_cast<uint32_t>(shift) % 32u;
+  value_.resize(n + d + (b != 0 ? 1 : 0));
+  uint32_t *r = value_.data();
+  if (b == 0) {
+    std::copy_backward(r, r + n, r + n + d);
+  } else {
+    r[n + d] = r[n - 1] >> (32u - b);
+    for (size_t i = n - 1; i > 0; --i) {
+      r[i + d] = (r[i] << b) | (r[i - 1] >> (32u - b));
+    }
+    r[d] = r[0] << b;
   }
-  res.mul_short_(1u << shift % 32u);
-  swap(res);
-  return *this;
+  std::fill(r, r + d, 0);
+  // only the limb receiving the bits shifted out of the old top limb can be zero
+  return trim_(b != 0 && r[n + d] == 0 ? n + d : size());
 }
 
+// Rounds towards minus infinity: a negative value whose shifted out bits are not all zero gets its magnitude
+// increased by one
 big_integer &big_integer::operator>>=(int shift) {
-  big_integer res(sign_, 0);
-  size_t d = static_cast<size_t>(shift / 32u);
-  for (size_t i = d; i < size(); ++i) {
-    res.value_.push_back(value_[i]);
+  size_t const d = static_cast<size_t>(shift) / 32u, n = size();
+  uint32_t const b = static_cast<uint32_t>(shift) % 32u;
+  bool lost = false;
+  if (sign_) {
+    storage_t const &lhs = value_;
+    uint32_t const *a = lhs.data();
+    for (size_t i = 0; i < std::min(d, n) && !lost; ++i) {
+      lost = a[i] != 0;
+    }
+    lost = lost || (d < n && (a[d] & ((1u << b) - 1)) != 0);
   }
-  res.value_.push_back(0);
-  if (res < 0) {
-    res -= static_cast<uint64_t>(1ull << shift % 32u) - 1;
+  if (d >= n) {
+    return assign_wide_(sign_, lost ? 1 : 0);
   }
-  res.div_short_(1u << shift % 32u);
-  swap(res);
-  return *this;
+  uint32_t *r = value_.data();
+  if (b == 0) {
+    std::copy(r + d, r + n, r);
+  } else {
+    for (size_t i = 0; i + d + 1 < n; ++i) {
+      r[i] = (r[i + d] >> b) | (r[i + d + 1] << (32u - b));
+    }
+    r[n - d - 1] = r[n - 1] >> b;
+  }
+  // the old top limb is not zero, so its bits reach at least the limb below the new top one
+  value_.resize(n - d > 1 && r[n - d - 1] == 0 ? n - d - 1 : n - d);
+  if (lost) {
+    add_short_abs_(1);
+  }
+  return trim_(size());
 }
 
 //--------------------------------------------------Unary-operations----------------------------------------------------
@@ -329,8 +478,7 @@ big_integer big_integer::operator+() const {
 
 big_integer big_integer::operator-() const {
   big_integer res = *this;
-  res.sign_ = !res.sign_;
-  res.to_normal_form();
+  res.negate();
   return res;
 }
 
@@ -360,92 +508,391 @@ big_integer big_integer::operator--(int) {
 
 //------------------------------------------------Binary-operations-----------------------------------------------------
 
-big_integer operator+(big_integer a, big_integer const &b) {
-  return a += b;
+big_integer operator+(big_integer const &a, big_integer const &b) {
+  return big_integer(a) += b;
+}
+
+big_integer operator+(big_integer &&a, big_integer const &b) {
+  return std::move(a += b);
 }
 
-big_integer operator-(big_integer a, big_integer const &b) {
-  return a -= b;
+big_integer operator+(big_integer const &a, big_integer &&b) {
+  return std::move(b += a);
 }
 
-big_integer operator*(big_integer a, big_integer const &b) {
-  return a *= b;
+big_integer operator+(big_integer &&a, big_integer &&b) {
+  if (b.capacity() > a.capacity()) {
+    return std::move(b += a);
+  }
+  return std::move(a += b);
+}
+
+big_integer operator-(big_integer const &a, big_integer const &b) {
+  return big_integer(a) -= b;
 }
 
-big_integer operator/(big_integer a, big_integer const &b) {
-  return a /= b;
+big_integer operator-(big_integer &&a, big_integer const &b) {
+  return std::move(a -= b);
 }
 
-big_integer operator%(big_integer a, big_integer const &b) {
-  return a %= b;
+big_integer operator-(big_integer const &a, big_integer &&b) {
+  return std::move((b -= a).negate());
+}
+
+big_integer operator-(big_integer &&a, big_integer &&b) {
+  if (b.capacity() > a.capacity()) {
+    return std::move((b -= a).negate());
+  }
+  return std::move(a -= b);
+}
+
+big_integer operator*(big_integer const &a, big_integer const &b) {
+  return big_integer(a) *= b;
+}
+
+big_integer operator*(big_integer &&a, big_integer const &b) {
+  return std::move(a *= b);
+}
+
+big_integer operator*(big_integer const &a, big_integer &&b) {
+  return std::move(b *= a);
+}
+
+big_integer operator*(big_integer &&a, big_integer &&b) {
+  if (b.capacity() > a.capacity()) {
+    return std::move(b *= a);
+  }
+  return std::move(a *= b);
+}
+
+big_integer operator/(big_integer const &a, big_integer const &b) {
+  return big_integer(a) /= b;
+}
+
+big_integer operator/(big_integer &&a, big_integer const &b) {
+  return std::move(a /= b);
+}
+
+big_integer operator%(big_integer const &a, big_integer const &b) {
+  return big_integer(a) %= b;
+}
+
+big_integer operator%(big_integer &&a, big_integer const &b) {
+  return std::move(a %= b);
 }
 
 // Bitwise operations
 
-big_integer operator&(big_integer a, big_integer const &b) {
-  return a &= b;
+big_integer operator&(big_integer const &a, big_integer const &b) {
+  return big_integer(a) &= b;
+}
+
+big_integer operator&(big_integer &&a, big_integer const &b) {
+  return std::move(a &= b);
 }
 
-big_integer operator|(big_integer a, big_integer const &b) {
-  return a |= b;
+big_integer operator&(big_integer const &a, big_integer &&b) {
+  return std::move(b &= a);
 }
 
-big_integer operator^(big_integer a, big_integer const &b) {
-  return a ^= b;
+big_integer operator&(big_integer &&a, big_integer &&b) {
+  if (b.capacity() > a.capacity()) {
+    return std::move(b &= a);
+  }
+  return std::move(a &= b);
+}
+
+big_integer operator|(big_integer const &a, big_integer const &b) {
+  return big_integer(a) |= b;
+}
+
+big_integer operator|(big_integer &&a, big_integer const &b) {
+  return std::move(a |= b);
+}
+
+big_integer operator|(big_integer const &a, big_integer &&b) {
+  return std::move(b |= a);
+}
+
+big_integer operator|(big_integer &&a, big_integer &&b) {
+  if (b.capacity() > a.capacity()) {
+    return std::move(b |= a);
+  }
+  return std::move(a |= b);
+}
+
+big_integer operator^(big_integer const &a, big_integer const &b) {
+  return big_integer(a) ^= b;
+}
+
+big_integer operator^(big_integer &&a, big_integer const &b) {
+  return std::move(a ^= b);
+}
+
+big_integer operator^(big_integer const &a, big_integer &&b) {
+  return std::move(b ^= a);
+}
+
+big_integer operator^(big_integer &&a, big_integer &&b) {
+  if (b.capacity() > a.capacity()) {
+    return std::move(b ^= a);
+  }
+  return std::move(a ^= b);
 }
 
 // Shifts
 
-big_integer operator<<(big_integer a, int b) {
-  return a = a <<= b;
+big_integer operator<<(big_integer const &a, int b) {
+  return big_integer(a) <<= b;
+}
+
+big_integer operator<<(big_integer &&a, int b) {
+  return std::move(a <<= b);
+}
+
+big_integer operator>>(big_integer const &a, int b) {
+  return big_integer(a) >>= b;
 }
 
-big_integer operator>>(big_integer a, int b) {
-  return a = a >>= b;
+big_integer operator>>(big_integer &&a, int b) {
+  return std::move(a >>= b);
 }
 
 //---------------------------------------------------Comparison---------------------------------------------------------
 
+int compare(big_integer const &a, big_integer const &b) {
+  if (a.sign_ != b.sign_) {
+    return a.sign_ ? -1 : 1;
+  }
+  int const abs_cmp = big_integer::compare_abs(a.value_.data(), a.size(), b.value_.data(), b.size());
+  return a.sign_ ? -abs_cmp : abs_cmp;
+}
+
+#ifdef BIGINT_HAS_THREE_WAY_COMPARISON
+std::strong_ordering operator<=>(big_integer const &a, big_integer const &b) {
+  return compare(a, b) <=> 0;
+}
+#endif
+
 bool operator==(big_integer const &a, big_integer const &b) {
-  return a.sign_ == b.sign_ && a.value_ == b.value_;
+  return compare(a, b) == 0;
 }
 
 bool operator!=(big_integer const &a, big_integer const &b) {
-  return !(a == b);
+  return compare(a, b) != 0;
 }
 
 bool operator<(big_integer const &a, big_integer const &b) {
-  if (a.sign_ != b.sign_) {
-    return a.sign_ && !b.sign_;
-  }
-  if (a.sign_) {
-    return big_integer::less_abs(b, a);
-  }
-  return big_integer::less_abs(a, b);
+  return compare(a, b) < 0;
 }
 
 bool operator>(big_integer const &a, big_integer const &b) {
-  return !(a < b) && (a != b);
+  return compare(a, b) > 0;
 }
 
 bool operator<=(big_integer const &a, big_integer const &b) {
-  return !(a > b);
+  return compare(a, b) <= 0;
 }
 
 bool operator>=(big_integer const &a, big_integer const &b) {
-  return !(a < b);
+  return compare(a, b) >= 0;
+}
+
+//-------------------------------------------Number-theoretic-functions-------------------------------------------------
+
+namespace {
+
+__extension__ typedef __int128 int128_t;
+
+uint64_t binary_gcd(uint64_t a, uint64_t b) {
+  if (a == 0 || b == 0) {
+    return a | b;
+  }
+  int const shift = __builtin_ctzll(a | b);
+  a >>= __builtin_ctzll(a);
+  while (b != 0) {
+    b >>= __builtin_ctzll(b);
+    if (a > b) {
+      std::swap(a, b);
+    }
+    b -= a;
+  }
+  return a << shift;
+}
+
+// Lehmer's step: runs Euclid on the leading bits ah >= bh of a and b for as long as the quotients are certain to
+// match those of a and b, and returns the cofactors with (a, b) -> (A a + B b, C a + D b); B == 0 if none was
+struct lehmer_matrix {
+  int64_t A, B, C, D;
+
+  lehmer_matrix(uint64_t ah, uint64_t bh) : A(1), B(0), C(0), D(1) {
+    int128_t x = ah, y = bh;
+    while (y + C != 0 && y + D != 0) {
+      int128_t const q = (x + A) / (y + C);
+      if (q != (x + B) / (y + D)) {
+        break;
+      }
+      int64_t t = static_cast<int64_t>(A - q * C);
+      A = C;
+      C = t;
+      t = static_cast<int64_t>(B - q * D);
+      B = D;
+      D = t;
+      int128_t const r = x - q * y;
+      x = y;
+      y = r;
+    }
+  }
+
+  void apply(big_integer &x, big_integer &y) const {
+    big_integer next_x = x * A + y * B;
+    y = x * C + y * D;
+    x.swap(next_x);
+  }
+};
+
+}
+
+// 64 bits of |*this| starting at bit pos
+uint64_t big_integer::bits_at_(size_t pos) const {
+  storage_t const &v = value_;
+  size_t const i = pos / 32;
+  uint128_t x = 0;
+  for (size_t j = std::min(size(), i + 3); j > i; --j) {
+    x = (x << 32u) | v[j - 1];
+  }
+  return static_cast<uint64_t>(x >> (pos % 32));
+}
+
+big_integer gcd(big_integer const &a, big_integer const &b) {
+  if (a.is_word() && b.is_word()) {
+    return binary_gcd(a.word(), b.word());
+  }
+  big_integer x = a, y = b;
+  x.sign_ = y.sign_ = false;
+  if (x < y) {
+    x.swap(y);
+  }
+  while (!y.is_word()) {
+    // leading 62 bits, so that the matrix entries and x + A, y + D stay within int64_t
+    size_t const pos = x.bit_length() - 62;
+    lehmer_matrix const m(x.bits_at_(pos), y.bits_at_(pos));
+    if (m.B == 0) {
+      x %= y;
+      x.swap(y);
+    } else {
+      m.apply(x, y);
+    }
+  }
+  if (y.is_zero()) {
+    return x;
+  }
+  return binary_gcd(y.word(), x.mod_native_(y.word()));
+}
+
+big_integer lcm(big_integer const &a, big_integer const &b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  big_integer res = divexact(a, gcd(a, b)) * b;
+  return res < 0 ? -res : res;
+}
+
+big_integer gcdext(big_integer const &a, big_integer const &b, big_integer &s, big_integer &t) {
+  big_integer x = a, y = b;
+  x.sign_ = y.sign_ = false;
+  bool const swapped = x < y;
+  if (swapped) {
+    x.swap(y);
+  }
+  big_integer const x0 = x, y0 = y;
+  // x = sx * x0 + (...) * y0 and the same for y
+  big_integer sx = 1, sy = 0;
+  while (!y.is_zero()) {
+    size_t const pos = x.bit_length() > 62 ? x.bit_length() - 62 : 0;
+    lehmer_matrix const m(x.bits_at_(pos), y.bits_at_(pos));
+    if (y.is_word() || m.B == 0) {
+      big_integer const q = x / y;
+      x -= q * y;
+      sx -= q * sy;
+      x.swap(y);
+      sx.swap(sy);
+    } else {
+      m.apply(x, y);
+      m.apply(sx, sy);
+    }
+  }
+  big_integer tx = y0.is_zero() ? big_integer() : divexact(x - sx * x0, y0);
+  if (swapped) {
+    sx.swap(tx);
+  }
+  s = a.sign_ ? -sx : sx;
+  t = b.sign_ ? -tx : tx;
+  return x;
+}
+
+// Hensel division: with b odd, every quotient limb is q[i] = r[i] * b^-1 mod 2^32, which clears limb i of the
+// remainder. No trial quotients or corrections are needed, and only the low limbs that later quotient limbs
+// depend on are ever updated.
+big_integer divexact(big_integer const &a, big_integer const &b) {
+  if (b.is_zero()) {
+    throw std::runtime_error("division by zero");
+  }
+  big_integer x = a, y = b;
+  x.sign_ = y.sign_ = false;
+  size_t zeros = 0;
+  while (!y.bit(zeros)) {
+    ++zeros;
+  }
+  x >>= static_cast<int>(zeros);
+  y >>= static_cast<int>(zeros);
+  if (x.size() < y.size()) {
+    return 0;
+  }
+  size_t const n = x.size(), m = y.size(), qn = n - m + 1;
+  storage_t const &divisor = y.value_;
+  uint32_t const *d = divisor.data();
+  // Newton iteration doubles the number of correct low bits: 3, 6, 12, 24, 48
+  uint32_t inv = d[0];
+  for (int i = 0; i < 4; ++i) {
+    inv *= 2 - d[0] * inv;
+  }
+  big_integer q(a.sign_ != b.sign_, qn);
+  uint32_t *r = x.value_.data(), *qp = q.value_.data();
+  for (size_t i = 0; i < qn; ++i) {
+    qp[i] = r[i] * inv;
+    size_t const len = std::min(m, qn - i);
+    uint64_t borrow = limbs_submul_1(r + i, d, len, qp[i]);
+    for (size_t j = i + len; borrow != 0 && j < qn; ++j) {
+      uint64_t const diff = static_cast<uint64_t>(r[j]) - borrow;
+      r[j] = static_cast<uint32_t>(diff);
+      borrow = diff >> 63u;
+    }
+  }
+  // the quotient has n - m + 1 or n - m limbs
+  q.trim_(qp[qn - 1] != 0 ? qn : qn - 1);
+  return q;
 }
 
 //----------------------------------------------------Other-------------------------------------------------------------
 
 std::string to_string(big_integer const &a) {
-  big_integer tmp = a;
-  std::string ans;
-  if (a == 0) {
+  if (a.is_zero()) {
     return "0";
   }
-  while (tmp != 0) {
-    ans += static_cast<char>('0' + tmp.div_short_(10));
+  big_integer tmp = a;
+  uint32_t *r = tmp.value_.data();
+  size_t n = tmp.size();
+  std::string ans;
+  while (n > 0) {
+    uint32_t chunk = limbs_divrem_1(r, r, n, 1000000000);
+    while (n > 0 && r[n - 1] == 0) {
+      --n;
+    }
+    for (size_t i = 0; i < 9 && (n > 0 || chunk != 0); ++i) {
+      ans += static_cast<char>('0' + chunk % 10);
+      chunk /= 10;
+    }
   }
   if (a.sign_) {
     ans += "-";
@@ -456,8 +903,8 @@ std::string to_string(big_integer const &a) {
 
 big_integer::big_integer(bool sign, size_t size) : value_(size, 0), sign_(sign) {}
 
-size_t big_integer::size() const noexcept {
-  return value_.size();
+size_t big_integer::capacity() const {
+  return value_.capacity();
 }
 
 bool big_integer::is_zero() const {
@@ -465,33 +912,43 @@ bool big_integer::is_zero() const {
 }
 
 big_integer &big_integer::to_normal_form() {
-  while (size() > 1 && value_.back() == 0) {
-    value_.pop_back();
+  storage_t const &v = value_;
+  size_t len = size();
+  while (len > 1 && v[len - 1] == 0) {
+    --len;
   }
-  if (size() == 1 && value_.back() == 0) {
+  return trim_(len);
+}
+
+big_integer &big_integer::trim_(size_t len) {
+  storage_t const &v = value_;
+  if (len == 0) {
+    len = 1;
+  }
+  if (len < size()) {
+    value_.resize(len);
+  }
+  if (len == 1 && v[0] == 0) {
     sign_ = false;
   }
   return *this;
 }
 
 big_integer &big_integer::negate() noexcept {
-  sign_ = !sign_;
+  storage_t const &v = value_;
+  sign_ = !sign_ && !(size() == 1 && v[0] == 0);
   return *this;
 }
 
-bool big_integer::less_abs(big_integer const &a, big_integer const &b) {
-  if (a.size() != b.size()) {
-    return a.size() < b.size();
+int big_integer::compare_abs(uint32_t const *a, size_t n, uint32_t const *b, size_t m) {
+  if (n != m) {
+    return n < m ? -1 : 1;
   }
-  for (size_t i = a.size(), j = b.size(); i > 0 && j > 0; --i, --j) {
-    if (a.value_[i - 1] < b.value_[j - 1]) {
-      return true;
-    }
-    if (a.value_[i - 1] > b.value_[j - 1]) {
-      return false;
-    }
+  size_t const k = limbs_mismatch(a, b, n);
+  if (k == 0) {
+    return 0;
   }
-  return false;
+  return a[k - 1] < b[k - 1] ? -1 : 1;
 }
 
 std::ostream &operator<<(std::ostream &s, big_integer const &a) {
@@ -6,19 +6,54 @@
 #include <algorithm>
 #include <cstring>
 #include <stdexcept>
-#include "buffer.h"
+#include <type_traits>
+#include "storage.h"
+#include "limb_ops.h"
+
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#define BIGINT_HAS_THREE_WAY_COMPARISON
+#include <compare>
+#endif
 
 __extension__ typedef unsigned __int128 uint128_t;
 
 struct big_integer {
+ private:
+  //Integers whose magnitude fits into uint64_t; bool and character types convert through big_integer(int) instead
+  template <typename T>
+  using is_native = std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) <= sizeof(uint64_t) &&
+                                                     !std::is_same<T, bool>::value && !std::is_same<T, char>::value &&
+                                                     !std::is_same<T, wchar_t>::value &&
+                                                     !std::is_same<T, char16_t>::value &&
+                                                     !std::is_same<T, char32_t>::value>;
+  template <typename T, typename R>
+  using if_integral = typename std::enable_if<is_native<T>::value, R>::type;
+  template <typename T, typename R>
+  using if_signed = typename std::enable_if<is_native<T>::value && std::is_signed<T>::value, R>::type;
+  template <typename T, typename R>
+  using if_unsigned = typename std::enable_if<is_native<T>::value && std::is_unsigned<T>::value, R>::type;
+
+ public:
   big_integer();
   big_integer(big_integer const &other);
+  big_integer(big_integer &&other) noexcept;
   big_integer(int a);
   big_integer(uint64_t a);
   explicit big_integer(std::string const &str);
   void swap(big_integer &other) noexcept;
 
+  //Allows copies of this value to be made concurrently from several threads
+  big_integer &make_thread_safe();
+
+  //Number of significant bits of |*this|, 0 for zero
+  size_t bit_length() const;
+  //Bit i of |*this|
+  bool bit(size_t i) const;
+  //Whether d divides *this, without computing the quotient
+  bool divisible_by(uint32_t d) const;
+
   big_integer &operator=(big_integer const &other);
+  big_integer &operator=(big_integer &&other) noexcept;
 
   big_integer &operator+=(big_integer const &rhs);
   big_integer &operator-=(big_integer const &rhs);
@@ -26,6 +61,28 @@ struct big_integer {
   big_integer &operator/=(big_integer const &rhs);
   big_integer &operator%=(big_integer const &rhs);
 
+  //Native integer operands go straight to the one- and two-limb kernels
+  template <typename T>
+  if_integral<T, big_integer &> operator+=(T rhs) {
+    return add_native_(native_sign_(rhs), native_abs_(rhs));
+  }
+  template <typename T>
+  if_integral<T, big_integer &> operator-=(T rhs) {
+    return add_native_(!native_sign_(rhs), native_abs_(rhs));
+  }
+  template <typename T>
+  if_integral<T, big_integer &> operator*=(T rhs) {
+    return mul_native_(native_sign_(rhs), native_abs_(rhs));
+  }
+  template <typename T>
+  if_integral<T, big_integer &> operator/=(T rhs) {
+    return div_native_(native_sign_(rhs), native_abs_(rhs));
+  }
+  template <typename T>
+  if_integral<T, big_integer &> operator%=(T rhs) {
+    return assign_wide_(sign_, mod_native_(native_abs_(rhs)));
+  }
+
   big_integer &operator&=(big_integer const &rhs);
   big_integer &operator|=(big_integer const &rhs);
   big_integer &operator^=(big_integer const &rhs);
@@ -43,18 +100,89 @@ struct big_integer {
   big_integer &operator--();
   big_integer operator--(int);
 
-  friend big_integer operator+(big_integer a, big_integer const &b);
-  friend big_integer operator-(big_integer a, big_integer const &b);
-  friend big_integer operator*(big_integer a, big_integer const &b);
-  friend big_integer operator/(big_integer a, big_integer const &b);
-  friend big_integer operator%(big_integer a, big_integer const &b);
+  friend big_integer operator+(big_integer const &a, big_integer const &b);
+  friend big_integer operator+(big_integer &&a, big_integer const &b);
+  friend big_integer operator+(big_integer const &a, big_integer &&b);
+  friend big_integer operator+(big_integer &&a, big_integer &&b);
+  friend big_integer operator-(big_integer const &a, big_integer const &b);
+  friend big_integer operator-(big_integer &&a, big_integer const &b);
+  friend big_integer operator-(big_integer const &a, big_integer &&b);
+  friend big_integer operator-(big_integer &&a, big_integer &&b);
+  friend big_integer operator*(big_integer const &a, big_integer const &b);
+  friend big_integer operator*(big_integer &&a, big_integer const &b);
+  friend big_integer operator*(big_integer const &a, big_integer &&b);
+  friend big_integer operator*(big_integer &&a, big_integer &&b);
+  friend big_integer operator/(big_integer const &a, big_integer const &b);
+  friend big_integer operator/(big_integer &&a, big_integer const &b);
+  friend big_integer operator%(big_integer const &a, big_integer const &b);
+  friend big_integer operator%(big_integer &&a, big_integer const &b);
+
+  template <typename T>
+  friend if_integral<T, big_integer> operator+(big_integer a, T b) {
+    return std::move(a += b);
+  }
+  template <typename T>
+  friend if_integral<T, big_integer> operator+(T a, big_integer b) {
+    return std::move(b += a);
+  }
+  template <typename T>
+  friend if_integral<T, big_integer> operator-(big_integer a, T b) {
+    return std::move(a -= b);
+  }
+  template <typename T>
+  friend if_integral<T, big_integer> operator-(T a, big_integer b) {
+    return std::move((b -= a).negate());
+  }
+  template <typename T>
+  friend if_integral<T, big_integer> operator*(big_integer a, T b) {
+    return std::move(a *= b);
+  }
+  template <typename T>
+  friend if_integral<T, big_integer> operator*(T a, big_integer b) {
+    return std::move(b *= a);
+  }
+  template <typename T>
+  friend if_integral<T, big_integer> operator/(big_integer a, T b) {
+    return std::move(a /= b);
+  }
+  //The remainder has the sign of a and is less than |b|, so it fits into a signed T
+  template <typename T>
+  friend if_signed<T, T> operator%(big_integer const &a, T b) {
+    T const rem = static_cast<T>(a.mod_native_(native_abs_(b)));
+    return a.sign_ ? -rem : rem;
+  }
+  template <typename T>
+  friend if_signed<T, T> operator%(big_integer &&a, T b) {
+    return static_cast<big_integer const &>(a) % b;
+  }
+  template <typename T>
+  friend if_unsigned<T, big_integer> operator%(big_integer a, T b) {
+    return std::move(a %= b);
+  }
+
+  friend big_integer operator&(big_integer const &a, big_integer const &b);
+  friend big_integer operator&(big_integer &&a, big_integer const &b);
+  friend big_integer operator&(big_integer const &a, big_integer &&b);
+  friend big_integer operator&(big_integer &&a, big_integer &&b);
+  friend big_integer operator|(big_integer const &a, big_integer const &b);
+  friend big_integer operator|(big_integer &&a, big_integer const &b);
+  friend big_integer operator|(big_integer const &a, big_integer &&b);
+  friend big_integer operator|(big_integer &&a, big_integer &&b);
+  friend big_integer operator^(big_integer const &a, big_integer const &b);
+  friend big_integer operator^(big_integer &&a, big_integer const &b);
+  friend big_integer operator^(big_integer const &a, big_integer &&b);
+  friend big_integer operator^(big_integer &&a, big_integer &&b);
 
-  friend big_integer operator&(big_integer a, big_integer const &b);
-  friend big_integer operator|(big_integer a, big_integer const &b);
-  friend big_integer operator^(big_integer a, big_integer const &b);
+  friend big_integer operator<<(big_integer const &a, int b);
+  friend big_integer operator<<(big_integer &&a, int b);
+  friend big_integer operator>>(big_integer const &a, int b);
+  friend big_integer operator>>(big_integer &&a, int b);
 
-  friend big_integer operator<<(big_integer a, int b);
-  friend big_integer operator>>(big_integer a, int b);
+  //Negative, zero or positive as a is less than, equal to or greater than b; scans the limbs once
+  friend int compare(big_integer const &a, big_integer const &b);
+#ifdef BIGINT_HAS_THREE_WAY_COMPARISON
+  friend std::strong_ordering operator<=>(big_integer const &a, big_integer const &b);
+#endif
 
   friend bool operator==(big_integer const &a, big_integer const &b);
   friend bool operator!=(big_integer const &a, big_integer const &b);
@@ -63,10 +191,67 @@ struct big_integer {
   friend bool operator<=(big_integer const &a, big_integer const &b);
   friend bool operator>=(big_integer const &a, big_integer const &b);
 
+  template <typename T>
+  friend if_integral<T, bool> operator==(big_integer const &a, T b) {
+    return a.compare_native_(native_sign_(b), native_abs_(b)) == 0;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator!=(big_integer const &a, T b) {
+    return a.compare_native_(native_sign_(b), native_abs_(b)) != 0;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator<(big_integer const &a, T b) {
+    return a.compare_native_(native_sign_(b), native_abs_(b)) < 0;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator>(big_integer const &a, T b) {
+    return a.compare_native_(native_sign_(b), native_abs_(b)) > 0;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator<=(big_integer const &a, T b) {
+    return a.compare_native_(native_sign_(b), native_abs_(b)) <= 0;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator>=(big_integer const &a, T b) {
+    return a.compare_native_(native_sign_(b), native_abs_(b)) >= 0;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator==(T a, big_integer const &b) {
+    return b == a;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator!=(T a, big_integer const &b) {
+    return b != a;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator<(T a, big_integer const &b) {
+    return b > a;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator>(T a, big_integer const &b) {
+    return b < a;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator<=(T a, big_integer const &b) {
+    return b >= a;
+  }
+  template <typename T>
+  friend if_integral<T, bool> operator>=(T a, big_integer const &b) {
+    return b <= a;
+  }
+
   friend std::string to_string(big_integer const &a);
 
+  friend big_integer gcd(big_integer const &a, big_integer const &b);
+  friend big_integer gcdext(big_integer const &a, big_integer const &b, big_integer &s, big_integer &t);
+  friend big_integer divexact(big_integer const &a, big_integer const &b);
+  friend uint32_t trial_division(big_integer const &n, size_t count);
+  friend struct big_integer_accumulator;
+  friend struct montgomery_context;
+  friend struct barrett_context;
+
  private:
-  buffer value_;
+  storage_t value_;
   bool sign_;
 
   //Useful ctor
@@ -77,25 +262,91 @@ struct big_integer {
   big_integer &mul_short_(uint32_t val);
   uint32_t div_short_(uint32_t val);
 
-  size_t size() const noexcept;
+  //Machine-word fast path for operands of at most two limbs
+  bool is_word() const noexcept {
+    return size() <= 2;
+  }
+  uint64_t word() const noexcept {
+    uint32_t const *a = value_.data();
+    return size() == 1 ? a[0] : (static_cast<uint64_t>(a[1]) << 32u) | a[0];
+  }
+  big_integer &assign_wide_(bool sign, uint128_t magnitude) {
+    size_t n = 1;
+    while (n < 4 && (magnitude >> (32u * n)) != 0) {
+      ++n;
+    }
+    value_.resize(n);
+    uint32_t *r = value_.data();
+    for (size_t i = 0; i < n; ++i) {
+      r[i] = static_cast<uint32_t>(magnitude >> (32u * i));
+    }
+    sign_ = sign && magnitude != 0;
+    return *this;
+  }
+  big_integer &add_word_(bool sign, uint64_t magnitude) {
+    uint128_t const a = word();
+    if (sign_ == sign) {
+      return assign_wide_(sign_, a + magnitude);
+    }
+    return a >= magnitude ? assign_wide_(sign_, a - magnitude) : assign_wide_(sign, magnitude - a);
+  }
+
+  //Operations with a native integer given as sign and magnitude
+  template <typename T>
+  static bool native_sign_(T a) {
+    return a < T();
+  }
+  template <typename T>
+  static uint64_t native_abs_(T a) {
+    return a < T() ? -static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+  }
+  big_integer &add_native_(bool sign, uint64_t magnitude);
+  big_integer &mul_native_(bool sign, uint64_t magnitude);
+  big_integer &div_native_(bool sign, uint64_t magnitude);
+  uint64_t mod_native_(uint64_t magnitude) const;
+  int compare_native_(bool sign, uint64_t magnitude) const;
+
+  //In-place magnitude operations, the sign is kept unless |b| > |*this| in sub_abs_
+  void add_abs_(uint32_t const *b, size_t m);
+  void sub_abs_(uint32_t const *b, size_t m);
+  void mul_abs_(uint32_t const *b, size_t m);
+
+  size_t size() const noexcept {
+    return value_.size();
+  }
+  size_t capacity() const;
 
   bool is_zero() const;
+  //Strips high zero limbs and the sign of zero
   big_integer& to_normal_form();
+  //The same when the caller already knows the length len of the result: one resize, no scan
+  big_integer& trim_(size_t len);
+  //Keeps zero non-negative
   big_integer& negate() noexcept;
 
   //Division
-  uint32_t trial(uint64_t const k, uint64_t const m, big_integer const &d);
-  bool smaller(big_integer const &dq, uint64_t const k, uint64_t const m);
-  void difference(big_integer const &dq, uint64_t const k, uint64_t const m);
+  uint32_t trial(uint64_t const k, uint64_t const m, big_integer const &d) const;
 
   //Bitwise operations
-  static void to_additional_code(size_t size, big_integer const& src, big_integer &dst);
-  big_integer& bitwise_op(uint32_t (*op)(uint32_t, uint32_t), big_integer const& rhs);
+  template <typename Op>
+  big_integer& bitwise_op(Op op, limbs_bitwise_fn kernel, big_integer const& rhs);
+
+  //Number theory
+  uint64_t bits_at_(size_t pos) const;
 
   //Comparison
-  static bool less_abs(big_integer const &a, big_integer const &b);
+  static int compare_abs(uint32_t const *a, size_t n, uint32_t const *b, size_t m);
 };
 
 std::ostream &operator<<(std::ostream &s, big_integer const &a);
 
+//Greatest common divisor, non-negative; gcd(0, 0) = 0
+big_integer gcd(big_integer const &a, big_integer const &b);
+//Least common multiple, non-negative
+big_integer lcm(big_integer const &a, big_integer const &b);
+//Returns g = gcd(a, b) and sets s, t such that s * a + t * b = g
+big_integer gcdext(big_integer const &a, big_integer const &b, big_integer &s, big_integer &t);
+//a / b for b dividing a, computed from the low limbs up; the result is unspecified if b does not divide a
+big_integer divexact(big_integer const &a, big_integer const &b);
+
 #endif // BIG_INTEGER_H
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "big_integer.h"
+
+// Times typical big_integer workloads over the limb storage this binary was built with.
+// The storage_benchmark target builds and runs it for every BIGINT_STORAGE, build with -DCMAKE_BUILD_TYPE=Release.
+
+namespace {
+
+#if defined(BIGINT_STORAGE_VECTOR)
+char const *const storage_name = "vector";
+#elif defined(BIGINT_STORAGE_FIXED)
+char const *const storage_name = "fixed";
+#elif defined(BIGINT_STORAGE_ARENA)
+char const *const storage_name = "arena";
+#else
+char const *const storage_name = "buffer";
+#endif
+
+template <typename F>
+void run(char const *workload, F f) {
+  auto const start = std::chrono::steady_clock::now();
+  f();
+  double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::printf("%-16s %-7s %.3fs\n", workload, storage_name, seconds);
+}
+
+big_integer random_value(size_t limbs, uint64_t seed) {
+  big_integer r;
+  for (size_t i = 0; i < limbs; ++i) {
+    seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    r <<= 32;
+    r += static_cast<uint32_t>(seed >> 32u);
+  }
+  return r;
+}
+
+}
+
+int main() {
+  size_t volatile sink = 0;
+
+  run("small_arith", [&] {
+    big_integer a = 1;
+    for (uint32_t i = 1; i < 5000000; ++i) {
+      a = a * 3 + i;
+      a %= 1000000007;
+    }
+    sink += a.bit_length();
+  });
+
+  run("copy_small", [&] {
+    big_integer const a = 123456789;
+    std::vector<big_integer> v(1000);
+    for (size_t rep = 0; rep < 5000; ++rep) {
+      for (big_integer &x : v) {
+        x = a;
+      }
+    }
+    sink += v.back().bit_length();
+  });
+
+  run("copy_large", [&] {
+    big_integer const a = random_value(256, 1);
+    std::vector<big_integer> v(1000);
+    for (size_t rep = 0; rep < 2000; ++rep) {
+      for (big_integer &x : v) {
+        x = a;
+      }
+    }
+    sink += v.back().bit_length();
+  });
+
+  run("add_sub_64", [&] {
+    big_integer const a = random_value(64, 7), b = random_value(64, 8);
+    big_integer c = a;
+    for (size_t rep = 0; rep < 2000000; ++rep) {
+      c += b;
+      c -= a;
+    }
+    sink += c.bit_length();
+  });
+
+  run("mul_64", [&] {
+    big_integer const a = random_value(64, 2), b = random_value(64, 3);
+    for (size_t rep = 0; rep < 200000; ++rep) {
+      sink += (a * b).bit_length();
+    }
+  });
+
+  run("divmod_128_64", [&] {
+    big_integer const a = random_value(128, 4), b = random_value(64, 5);
+    for (size_t rep = 0; rep < 100000; ++rep) {
+      sink += (a / b).bit_length() + (a % b).bit_length();
+    }
+  });
+
+  run("to_string_64", [&] {
+    big_integer const a = random_value(64, 6);
+    for (size_t rep = 0; rep < 20000; ++rep) {
+      sink += to_string(a).size();
+    }
+  });
+
+  return 0;
+}
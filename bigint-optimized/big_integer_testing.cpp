@@ -2,11 +2,20 @@
 #include <cassert>
 #include <cstdlib>
 #include <random>
+#include <thread>
 #include <vector>
 #include <utility>
 #include <gtest/gtest.h>
 
 #include "big_integer.h"
+#include "accumulator.h"
+#include "montgomery.h"
+#include "barrett.h"
+#include "power.h"
+#include "invert.h"
+#include "root.h"
+#include "combinatorics.h"
+#include "prime.h"
 #include "big_integer_gmp.h"
 
 TEST(correctness, two_plus_two) {
@@ -815,3 +824,609 @@ TEST(correctness_twos_complement, all_ones) {
 
   EXPECT_EQ(to_string(gmp_ans), to_string(your_ans));
 }
+
+TEST(correctness_threads, shared_constant) {
+  big_integer constant = (big_integer(1) << 4096) - 1;
+  constant.make_thread_safe();
+  std::vector<std::thread> workers;
+  std::vector<big_integer> results(4);
+  for (size_t t = 0; t != results.size(); ++t) {
+    workers.emplace_back([&constant, &results, t] {
+      for (size_t i = 0; i != 1000; ++i) {
+        big_integer copy = constant;
+        copy += static_cast<int>(t);
+        results[t] = copy;
+      }
+    });
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (size_t t = 0; t != results.size(); ++t) {
+    EXPECT_EQ(constant + static_cast<int>(t), results[t]);
+  }
+}
+
+TEST(correctness, move_ctor_and_assignment) {
+  big_integer a = big_integer(1) << 200;
+  big_integer b = std::move(a);
+  EXPECT_EQ(big_integer(1) << 200, b);
+
+  EXPECT_EQ(0, a);
+
+  big_integer c = big_integer(1) << 300;
+  c = std::move(b);
+  EXPECT_EQ(big_integer(1) << 200, c);
+  EXPECT_EQ(0, b);
+  b += 7;
+  EXPECT_EQ(7, b);
+
+  c = std::move(c);
+  EXPECT_EQ(big_integer(1) << 200, c);
+}
+
+TEST(correctness, rvalue_operands) {
+  big_integer a = big_integer(1) << 100;
+  big_integer b = 7;
+
+  EXPECT_EQ(a + 7, a + std::move(b));
+  EXPECT_EQ(7 - a, big_integer(7) - big_integer(a));
+  EXPECT_EQ(-a + 7, big_integer(7) - a);
+  EXPECT_EQ(a * 7, big_integer(7) * big_integer(a));
+  EXPECT_EQ(a & 7, big_integer(7) & a);
+  EXPECT_EQ(a | 7, big_integer(7) | big_integer(a));
+  EXPECT_EQ(a ^ 7, 7 ^ big_integer(a));
+  EXPECT_EQ(a, big_integer(a) - 0);
+}
+
+TEST(correctness, copy_ctor_real_copy_long) {
+  big_integer a = (big_integer(1) << 300) + 12345;
+  big_integer b = a;
+  b /= 10;
+  b *= b;
+
+  EXPECT_EQ((big_integer(1) << 300) + 12345, a);
+  EXPECT_EQ(((big_integer(1) << 300) + 12345) / 10 * (((big_integer(1) << 300) + 12345) / 10), b);
+}
+
+TEST(correctness, add_sub_self_and_shared) {
+  big_integer a = (big_integer(1) << 128) - 1;
+  big_integer b = a;
+  a += a;
+  EXPECT_EQ((big_integer(1) << 129) - 2, a);
+  EXPECT_EQ((big_integer(1) << 128) - 1, b);
+
+  a -= b;
+  a -= b;
+  EXPECT_EQ(0, a);
+  a -= b;
+  EXPECT_EQ(-b, a);
+  a -= a;
+  EXPECT_EQ(0, a);
+}
+
+TEST(correctness_random, word_operands) {
+  std::vector<std::string> values = {"0", "1", "-1", "4294967295", "-4294967296", "4294967297",
+                                     "18446744073709551615", "-18446744073709551615", "9223372036854775808"};
+  for (std::string const& x : values) {
+    for (std::string const& y : values) {
+      big_integer_gmp a(x), b(y);
+      big_integer A(x), B(y);
+      EXPECT_EQ(to_string(a + b), to_string(A + B));
+      EXPECT_EQ(to_string(a - b), to_string(A - B));
+      EXPECT_EQ(to_string(a * b), to_string(A * B));
+      EXPECT_EQ(a < b, A < B);
+      EXPECT_EQ(a == b, A == B);
+      if (y != "0") {
+        EXPECT_EQ(to_string(a / b), to_string(A / B));
+        EXPECT_EQ(to_string(a % b), to_string(A % B));
+      }
+    }
+  }
+}
+
+TEST(correctness, native_operands) {
+  big_integer a = (big_integer(1) << 100) + 3;
+  big_integer b = -a;
+
+  EXPECT_EQ(a + big_integer(7), a + 7);
+  EXPECT_EQ(a - big_integer(7), a - 7u);
+  EXPECT_EQ(big_integer(7) - a, 7ll - a);
+  EXPECT_EQ(b * big_integer(-10), b * -10l);
+  EXPECT_EQ(a * big_integer(std::numeric_limits<uint64_t>::max()), a * std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(b / big_integer(7), b / static_cast<short>(7));
+  EXPECT_EQ(a / big_integer(std::numeric_limits<uint64_t>::max()), a / std::numeric_limits<uint64_t>::max());
+
+  int64_t const min = std::numeric_limits<int64_t>::min();
+  EXPECT_EQ(a / big_integer(std::to_string(min)), a / min);
+  EXPECT_EQ(to_string(b % big_integer(std::to_string(min))), std::to_string(b % min));
+
+  int rem = b % 7;
+  EXPECT_EQ(b % big_integer(7), rem);
+  EXPECT_EQ(a % big_integer(std::numeric_limits<uint64_t>::max()), a % std::numeric_limits<uint64_t>::max());
+  big_integer c = a;
+  c %= -7;
+  EXPECT_EQ(a % 7, c);
+
+  EXPECT_TRUE(b < 0);
+  EXPECT_TRUE(0 > b);
+  EXPECT_TRUE(a > std::numeric_limits<uint64_t>::max());
+  EXPECT_TRUE(big_integer(-5) == -5);
+  EXPECT_TRUE(big_integer(5) != -5);
+  EXPECT_TRUE(big_integer(0) >= 0u);
+  EXPECT_TRUE(big_integer(-1) <= 0u);
+
+  EXPECT_EQ(3, (big_integer(10) + 3) % 5);
+  EXPECT_EQ(-3, (big_integer(-10) - 3) % 5ll);
+  EXPECT_EQ(3, (big_integer(10) + 3) % 5u);
+}
+
+TEST(correctness, native_operand_limits) {
+  int64_t const min = std::numeric_limits<int64_t>::min();
+  int64_t const max = std::numeric_limits<int64_t>::max();
+  uint64_t const umax = std::numeric_limits<uint64_t>::max();
+
+  big_integer a;
+  a += min;
+  EXPECT_EQ("-9223372036854775808", to_string(a));
+  EXPECT_TRUE(a == min);
+  a -= max;
+  EXPECT_EQ("-18446744073709551615", to_string(a));
+  a += umax;
+  EXPECT_EQ(0, a);
+
+  EXPECT_EQ("9223372036854775808", to_string(big_integer() - min));
+  EXPECT_EQ("85070591730234615865843651857942052864", to_string(big_integer(1) * min * min));
+  EXPECT_EQ("340282366920938463426481119284349108225", to_string(big_integer(1) * umax * umax));
+  EXPECT_EQ(-1, big_integer(std::to_string(min)) / max);
+  EXPECT_EQ(1, big_integer(std::to_string(umax)) / umax);
+  EXPECT_TRUE(big_integer(std::to_string(max)) == max);
+  EXPECT_TRUE(big_integer(std::to_string(umax)) == umax);
+  EXPECT_TRUE(big_integer(std::to_string(umax)) > max);
+
+  //Not native operands: bool and char go through big_integer(int)
+  EXPECT_EQ(6, big_integer(5) + true);
+  EXPECT_EQ(97, big_integer(0) + 'a');
+}
+
+TEST(correctness, normal_form_of_results) {
+  big_integer const a = (big_integer(1) << 100) + 5;
+
+  EXPECT_EQ("0", to_string(-big_integer(0)));
+  EXPECT_EQ("0", to_string(big_integer(0) - a + a));
+  EXPECT_EQ("0", to_string(big_integer(5) - std::move(big_integer(5))));
+  EXPECT_EQ("0", to_string(big_integer("-0")));
+  EXPECT_EQ("0", to_string(big_integer(0) << 100));
+  EXPECT_EQ("0", to_string(-a * 0));
+  EXPECT_EQ(1, (big_integer(1) << 100) >> 100);
+  EXPECT_EQ(-1, -a >> 200);
+  EXPECT_EQ(-2, -a >> 100);
+  EXPECT_EQ(big_integer(1) << 36, a / (uint64_t(1) << 63) / (uint64_t(1) << 1));
+  EXPECT_EQ(big_integer(1) << 65, -a / -(int64_t(1) << 35));
+}
+
+TEST(correctness, three_way_compare) {
+  big_integer a = (big_integer(1) << 100) + 1;
+  big_integer b = (big_integer(1) << 100) + 2;
+
+  EXPECT_LT(compare(a, b), 0);
+  EXPECT_GT(compare(b, a), 0);
+  EXPECT_EQ(0, compare(a, a));
+  EXPECT_LT(compare(-b, -a), 0);
+  EXPECT_LT(compare(-a, 1), 0);
+  EXPECT_GT(compare(a, 1), 0);
+  EXPECT_EQ(0, compare(big_integer(0), -big_integer(0)));
+}
+
+TEST(correctness_random, bit_shifts_small) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations * 10; ++itn) {
+    big_integer_gmp a;
+    a.random(200, rng);
+    big_integer R = big_integer(to_string(a));
+    for (int shift : {0, 1, 31, 32, 33, 64, 95, 200, 300}) {
+      EXPECT_EQ(to_string(a << shift), to_string(R << shift));
+      EXPECT_EQ(to_string(a >> shift), to_string(R >> shift));
+    }
+  }
+}
+
+TEST(correctness_twos_complement, sign_combinations) {
+  std::vector<std::string> values = {"0", "-1", "1", "-4294967296", "-4294967297", "-9223372036854775808",
+                                     "-9223372036854775809", "18446744073709551615", "-18446744073709551616"};
+  for (std::string const& x : values) {
+    for (std::string const& y : values) {
+      big_integer_gmp a(x), b(y);
+      big_integer A(x), B(y);
+      EXPECT_EQ(to_string(a & b), to_string(A & B));
+      EXPECT_EQ(to_string(a | b), to_string(A | B));
+      EXPECT_EQ(to_string(a ^ b), to_string(A ^ B));
+    }
+    big_integer A(x);
+    EXPECT_EQ(to_string(~big_integer_gmp(x)), to_string(~A));
+    EXPECT_EQ(A, A & A);
+    EXPECT_EQ(0, A ^= A);
+  }
+}
+
+TEST(correctness, compare_long_single_limb_difference) {
+  big_integer base = (big_integer(1) << 3200) - 1;
+  for (int limb = 0; limb < 100; limb += 7) {
+    big_integer smaller = base - (big_integer(1) << (32 * limb));
+    EXPECT_TRUE(smaller < base);
+    EXPECT_TRUE(base > smaller);
+    EXPECT_TRUE(smaller != base);
+    EXPECT_EQ(base, smaller + (big_integer(1) << (32 * limb)));
+    EXPECT_EQ(smaller, base & smaller);
+    EXPECT_EQ(base, base | smaller);
+    EXPECT_EQ(big_integer(1) << (32 * limb), base ^ smaller);
+  }
+}
+
+TEST(correctness_random, every_kernel_set) {
+  std::default_random_engine rng(42);
+  for (char const *allowed : {"generic", "sse2", "avx2,bmi2-adx", "x86-64"}) {
+    limb_kernels_select(allowed);
+    if (std::string(allowed) == "generic") {
+      EXPECT_STREQ("generic", limb_kernel_isa("and"));
+      EXPECT_STREQ("generic", limb_kernel_isa("addmul_1"));
+    }
+    for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+      big_integer_gmp a, b;
+      a.random(max_size, rng);
+      b.random(max_size, rng);
+      big_integer A(to_string(a)), B(to_string(b));
+      EXPECT_EQ(to_string(a + b), to_string(A + B));
+      EXPECT_EQ(to_string(a - b), to_string(A - B));
+      EXPECT_EQ(to_string(a * b), to_string(A * B));
+      EXPECT_EQ(to_string(a ^ b), to_string(A ^ B));
+      EXPECT_EQ(a < b, A < B);
+      if (b != 0) {
+        EXPECT_EQ(to_string(a / b), to_string(A / B));
+        EXPECT_EQ(to_string(a % b), to_string(A % B));
+      }
+    }
+  }
+  limb_kernels_select(std::getenv("BIGINT_KERNELS"));
+  EXPECT_EQ(nullptr, limb_kernel_isa("no_such_kernel"));
+}
+
+TEST(correctness_random, accumulator) {
+  std::default_random_engine rng(42);
+  big_integer_accumulator acc;
+  big_integer expected;
+  for (size_t itn = 0; itn != 100 * number_of_iterations; ++itn) {
+    big_integer_gmp a;
+    a.random(max_size, rng);
+    big_integer A(to_string(a));
+    if (itn % 3 == 0) {
+      acc -= A;
+      expected -= A;
+    } else {
+      acc += A;
+      expected += A;
+    }
+  }
+  EXPECT_EQ(expected, acc.value());
+  acc.clear();
+  EXPECT_EQ(0, acc.value());
+}
+
+TEST(correctness, accumulator_carries) {
+  big_integer_accumulator acc;
+  big_integer const all_ones = (big_integer(1) << 320) - 1;
+  for (int i = 0; i < 100000; ++i) {
+    acc += all_ones;
+    acc += 1;
+  }
+  EXPECT_EQ(big_integer(100000) << 320, acc.value());
+  acc -= big_integer(100000) << 320;
+  EXPECT_EQ(0, acc.value());
+}
+
+TEST(correctness_random, square) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a;
+    a.random(max_size, rng);
+    big_integer A(to_string(a));
+    EXPECT_EQ(to_string(a * a), to_string(A * A));
+    big_integer B = A;
+    EXPECT_EQ(to_string(a * a), to_string(B *= B));
+  }
+}
+
+TEST(correctness_random, montgomery) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp m, a, b;
+    m.random(max_size, rng);
+    a.random(max_size, rng);
+    b.random(2 * max_size, rng);
+    big_integer M(to_string(m)), A(to_string(a)), B(to_string(b));
+    M = (M < 0 ? -M : M) | 1;
+    montgomery_context ctx(M);
+    big_integer x = ctx.to_montgomery(A), y = ctx.to_montgomery(B);
+    big_integer expected_a = (A % M + M) % M, expected_b = (B % M + M) % M;
+    EXPECT_EQ(expected_a, ctx.from_montgomery(x));
+    EXPECT_EQ(expected_a * expected_b % M, ctx.from_montgomery(ctx.multiply(x, y)));
+    EXPECT_EQ(expected_a * expected_a % M, ctx.from_montgomery(ctx.square(x)));
+  }
+}
+
+TEST(correctness, montgomery_modpow) {
+  montgomery_context ctx(big_integer(1000000007));
+  EXPECT_EQ(1, ctx.modpow(2, 1000000006));
+  EXPECT_EQ(1, ctx.modpow(12345, 0));
+  EXPECT_EQ(1000000007 - 8, ctx.modpow(-2, 3));
+
+  big_integer const m = (big_integer(1) << 2203) - 1;
+  montgomery_context mersenne(m);
+  EXPECT_EQ(1, mersenne.modpow(3, m - 1));
+  EXPECT_EQ(big_integer(1) << 203, mersenne.modpow(2, 2203 * 7 + 203));
+  EXPECT_EQ(0, montgomery_context(1).modpow(5, 5));
+  EXPECT_THROW(montgomery_context(10), std::runtime_error);
+  EXPECT_THROW(montgomery_context(-7), std::runtime_error);
+  EXPECT_THROW(ctx.modpow(2, -1), std::runtime_error);
+}
+
+TEST(correctness_random, barrett) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp m, a, b;
+    m.random(max_size, rng);
+    a.random(max_size, rng);
+    b.random(max_size, rng);
+    big_integer M(to_string(m)), A(to_string(a)), B(to_string(b));
+    M = (M < 0 ? -M : M) + 1;
+    barrett_context ctx(M);
+    big_integer const x = (A % M + M) % M, y = (B % M + M) % M;
+    EXPECT_EQ(x * y % M, ctx.multiply(x, y));
+    EXPECT_EQ(x, ctx.reduce(A));
+    EXPECT_EQ(x * y * x % M, ctx.reduce(x * y * x));
+  }
+}
+
+TEST(correctness, barrett_edge_cases) {
+  big_integer const m = big_integer(1) << 100;
+  barrett_context ctx(m);
+  EXPECT_EQ(0, ctx.reduce(m));
+  EXPECT_EQ(m - 1, ctx.reduce(m * m - 1));
+  EXPECT_EQ(m - 1, ctx.reduce(-1));
+  EXPECT_EQ(5, barrett_context(7).reduce(12));
+  EXPECT_EQ(0, barrett_context(1).reduce(12345));
+  EXPECT_THROW(barrett_context(0), std::runtime_error);
+}
+
+TEST(correctness, pow) {
+  EXPECT_EQ(1, pow(big_integer(0), 0));
+  EXPECT_EQ(0, pow(big_integer(0), 5));
+  EXPECT_EQ(1024, pow(big_integer(2), 10));
+  EXPECT_EQ(-2187, pow(big_integer(-3), 7));
+  EXPECT_EQ(big_integer(1) << 4000, pow(big_integer(2), 4000));
+  big_integer expected = 1, base("123456789012345678901234567890");
+  for (uint64_t exp = 0; exp < 300; ++exp) {
+    EXPECT_EQ(expected, pow(base, exp));
+    expected *= base;
+  }
+}
+
+TEST(correctness_random, powmod) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a, e, m;
+    a.random(max_size, rng);
+    e.random(max_size / 4, rng);
+    m.random(max_size / 2, rng);
+    big_integer A(to_string(a)), E(to_string(e)), M(to_string(m));
+    E = E < 0 ? -E : E;
+    M = M == 0 ? big_integer(2) : M;
+    for (big_integer const &mod : {M, M * 2}) {
+      big_integer expected = 1, abs_m = mod < 0 ? -mod : mod, x = (A % abs_m + abs_m) % abs_m;
+      for (size_t i = E.bit_length(); i > 0; --i) {
+        expected = expected * expected % abs_m;
+        if (E.bit(i - 1)) {
+          expected = expected * x % abs_m;
+        }
+      }
+      EXPECT_EQ(expected, powmod(A, E, mod));
+    }
+  }
+  EXPECT_EQ(0, powmod(5, 0, 1));
+  EXPECT_EQ(1, powmod(5, 0, 8));
+  EXPECT_EQ(1, powmod(3, big_integer(1) << 100, 16));
+  EXPECT_THROW(powmod(2, 3, 0), std::runtime_error);
+  EXPECT_THROW(powmod(2, -3, 7), std::runtime_error);
+}
+
+TEST(correctness, gcd) {
+  EXPECT_EQ(0, gcd(0, 0));
+  EXPECT_EQ(5, gcd(0, -5));
+  EXPECT_EQ(6, gcd(-12, 18));
+  EXPECT_EQ(36, lcm(-12, 18));
+  EXPECT_EQ(0, lcm(0, 18));
+  big_integer const f = pow(big_integer(3), 100), g = pow(big_integer(5), 80), h = pow(big_integer(7), 60);
+  EXPECT_EQ(h, gcd(f * h, g * h));
+  EXPECT_EQ(f * g * h, lcm(f * h, g * h));
+  EXPECT_EQ(1, gcd(f, g));
+  EXPECT_EQ(f, gcd(f, f));
+}
+
+TEST(correctness_random, gcd) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a, b, c;
+    a.random(max_size, rng);
+    b.random(max_size / 2, rng);
+    c.random(max_size / 4, rng);
+    big_integer A(to_string(a)), B(to_string(b)), C(to_string(c));
+    for (big_integer const &x : {A, A * C}) {
+      for (big_integer const &y : {B, B * C, C}) {
+        big_integer expected = x < 0 ? -x : x, r = y < 0 ? -y : y;
+        while (r != 0) {
+          expected %= r;
+          expected.swap(r);
+        }
+        EXPECT_EQ(expected, gcd(x, y));
+        big_integer s, t;
+        EXPECT_EQ(expected, gcdext(x, y, s, t));
+        EXPECT_EQ(expected, s * x + t * y);
+      }
+    }
+  }
+}
+
+TEST(correctness, invert) {
+  EXPECT_EQ(4, invert(3, 11));
+  EXPECT_EQ(7, invert(-3, 11));
+  EXPECT_EQ(4, invert(3, -11));
+  EXPECT_EQ(0, invert(5, 1));
+  EXPECT_THROW(invert(4, 10), std::runtime_error);
+  EXPECT_THROW(invert(4, 0), std::runtime_error);
+  big_integer const m = (big_integer(1) << 521) - 1;
+  big_integer const a = pow(big_integer(3), 300);
+  EXPECT_EQ(1, invert(a, m) * a % m);
+}
+
+TEST(correctness_random, batch_invert) {
+  std::default_random_engine rng(42);
+  big_integer_gmp mg;
+  mg.random(max_size, rng);
+  big_integer m(to_string(mg));
+  m = (m < 0 ? -m : m) * 2 + 1;
+  std::vector<big_integer> values;
+  for (size_t itn = 0; itn != 10 * number_of_iterations; ++itn) {
+    big_integer_gmp a;
+    a.random(max_size, rng);
+    big_integer A(to_string(a));
+    if (gcd(A, m) == 1) {
+      values.push_back(A);
+    }
+  }
+  std::vector<big_integer> const inverses = batch_invert(values, m);
+  ASSERT_EQ(values.size(), inverses.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(invert(values[i], m), inverses[i]);
+  }
+  EXPECT_TRUE(batch_invert({}, m).empty());
+  EXPECT_THROW(batch_invert({3, 5, 6}, 9), std::runtime_error);
+}
+
+TEST(correctness, sqrt_and_root) {
+  for (int i = 0; i < 1000; ++i) {
+    big_integer const r = sqrt(big_integer(i));
+    EXPECT_TRUE(r * r <= i && (r + 1) * (r + 1) > i);
+  }
+  big_integer rem;
+  EXPECT_EQ(big_integer(1) << 500, sqrtrem(big_integer(1) << 1000, rem));
+  EXPECT_EQ(0, rem);
+  EXPECT_EQ(-3, root(-27, 3));
+  EXPECT_EQ(-3, root(-63, 3));
+  EXPECT_EQ(2, root(1023, 9));
+  EXPECT_THROW(sqrt(big_integer(-1)), std::runtime_error);
+  EXPECT_THROW(root(16, 0), std::runtime_error);
+}
+
+TEST(correctness_random, sqrt_and_root) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a;
+    a.random(max_size, rng);
+    big_integer A(to_string(a));
+    A = A < 0 ? -A : A;
+    big_integer rem;
+    big_integer const r = sqrtrem(A, rem);
+    EXPECT_TRUE(rem >= 0 && rem <= 2 * r);
+    EXPECT_EQ(A, r * r + rem);
+    EXPECT_EQ(r, sqrt(r * r));
+    for (unsigned k : {3u, 5u, 64u}) {
+      big_integer const x = root(A, k);
+      EXPECT_TRUE(pow(x, k) <= A && pow(x + 1, k) > A);
+      EXPECT_EQ(x, root(pow(x, k), k));
+    }
+  }
+}
+
+TEST(correctness, factorial_binomial_primorial) {
+  EXPECT_EQ(1, factorial(0));
+  EXPECT_EQ(1, factorial(1));
+  EXPECT_EQ(big_integer("2432902008176640000"), factorial(20));
+  big_integer expected = 1;
+  for (uint32_t n = 1; n <= 1000; ++n) {
+    expected *= n;
+    if (n % 97 == 0) {
+      EXPECT_EQ(expected, factorial(n));
+    }
+  }
+  EXPECT_EQ(1, binomial(0, 0));
+  EXPECT_EQ(0, binomial(3, 4));
+  EXPECT_EQ(252, binomial(10, 5));
+  EXPECT_EQ(factorial(300) / (factorial(120) * factorial(180)), binomial(300, 120));
+  EXPECT_EQ(1, primorial(1));
+  EXPECT_EQ(big_integer("6469693230"), primorial(30));
+  EXPECT_EQ(primorial(100), primorial(101) / 101);
+}
+
+TEST(correctness, probable_prime) {
+  int const small[] = {-7, 0, 1, 2, 3, 4, 97, 561, 997, 1009, 7919, 1000003, 999999937};
+  for (int n : small) {
+    bool prime = n >= 2;
+    for (int d = 2; d * d <= n; ++d) {
+      prime = prime && n % d != 0;
+    }
+    EXPECT_EQ(prime, is_probable_prime(n));
+  }
+  // 149491 * 747451 * 34233211, a strong pseudoprime to the primes up to 23
+  big_integer const spsp("3825123056546413051");
+  EXPECT_TRUE(is_probable_prime(spsp, {2, 3, 5, 7, 11, 13, 17, 19, 23}));
+  EXPECT_FALSE(is_probable_prime(spsp));
+  // 399165290221 * 798330580441, the smallest strong pseudoprime to the primes up to 37
+  big_integer const spsp37("318665857834031151167461");
+  EXPECT_TRUE(is_probable_prime(spsp37, {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}));
+  EXPECT_FALSE(is_probable_prime(spsp37));
+  big_integer const m127 = (big_integer(1) << 127) - 1, m2203 = (big_integer(1) << 2203) - 1;
+  EXPECT_TRUE(is_probable_prime(m127));
+  EXPECT_TRUE(is_probable_prime(m2203));
+  EXPECT_FALSE(is_probable_prime(m127 * m2203));
+  EXPECT_FALSE(is_probable_prime((big_integer(1) << 2201) - 1));
+  EXPECT_FALSE(is_probable_prime(big_integer(1000003) * 1000033));
+}
+
+TEST(correctness_random, divexact) {
+  std::default_random_engine rng(42);
+  for (size_t itn = 0; itn != number_of_iterations; ++itn) {
+    big_integer_gmp a, b;
+    a.random(max_size, rng);
+    b.random(max_size / 2, rng);
+    big_integer A(to_string(a)), B(to_string(b));
+    B = B == 0 ? big_integer(1) : B;
+    for (big_integer const &d : {B, B << 37, B * A, big_integer(-3), big_integer(1) << 100}) {
+      EXPECT_EQ(A, divexact(A * d, d));
+    }
+  }
+  EXPECT_EQ(0, divexact(0, 5));
+  EXPECT_EQ(-7, divexact(21, -3));
+  EXPECT_THROW(divexact(1, 0), std::runtime_error);
+}
+
+TEST(correctness, divisible_by_and_trial_division) {
+  big_integer const f = factorial(50);
+  for (uint32_t d = 1; d <= 60; ++d) {
+    EXPECT_EQ(f % d == 0, f.divisible_by(d));
+  }
+  EXPECT_TRUE(big_integer(0).divisible_by(7));
+  EXPECT_TRUE((-f).divisible_by(47));
+  EXPECT_THROW(f.divisible_by(0), std::runtime_error);
+
+  big_integer const m = (big_integer(1) << 127) - 1;
+  EXPECT_EQ(0, trial_division(m, 1000));
+  EXPECT_EQ(7919, trial_division(m * 7919, 1000));
+  EXPECT_EQ(0, trial_division(m * 7919, 999));
+  EXPECT_EQ(3, trial_division(m * 7919 * 3, 2));
+  EXPECT_EQ(0, trial_division(m * 7919 * 3, 1));
+  EXPECT_EQ(2, trial_division(0, 10));
+  EXPECT_EQ(0, trial_division(m, 0));
+  // the 10000th prime
+  EXPECT_EQ(104729, trial_division(m * 104729, 10000));
+  EXPECT_EQ(0, trial_division(m * 104729, 9999));
+}
@@ -1,4 +1,5 @@
 #include "buffer.h"
+#include "limb_ops.h"
 
 buffer::buffer(size_t size, uint32_t val) : size_(size), small_(size <= MAX_STATIC_SIZE) {
   if (small_) {
@@ -13,10 +14,14 @@ buffer::buffer(const buffer &other) {
   small_ = other.small_;
   dynamic_data_ = other.dynamic_data_;
   if (!other.small_) {
-    dynamic_data_->ref_counter += 1;
+    dynamic_data_->acquire();
   }
 }
 
+buffer::buffer(buffer &&other) noexcept {
+  steal(other);
+}
+
 buffer::~buffer() {
   if (!small_) {
     unshare();
@@ -44,6 +49,15 @@ uint32_t const& buffer::back() const {
   return (*this)[size_ - 1];
 }
 
+uint32_t *buffer::data() {
+  realloc_dynamic_data();
+  return small_ ? static_data_ : dynamic_data_->data_.data();
+}
+
+uint32_t const *buffer::data() const {
+  return small_ ? static_data_ : dynamic_data_->data_.data();
+}
+
 void buffer::resize(size_t new_size, uint32_t val) {
   if (small_ && new_size <= MAX_STATIC_SIZE) {
     if (size_ < new_size) {
@@ -68,23 +82,22 @@ buffer &buffer::operator=(buffer const &other) {
   small_ = other.small_;
   dynamic_data_ = other.dynamic_data_;
   if (!other.small_) {
-    dynamic_data_->ref_counter += 1;
+    dynamic_data_->acquire();
   }
   return *this;
 }
 
-bool buffer::operator==(buffer const &other) const {
-  if (size_ != other.size_) {
-    return false;
-  } else if (small_ && other.small_) {
-    return std::equal(static_data_, static_data_ + size_, other.static_data_);
-  } else if (small_ && !other.small_) {
-    return std::equal(static_data_, static_data_ + size_, other.dynamic_data_->data_.begin());
-  } else if (!small_ && other.small_) {
-    return std::equal(other.static_data_, other.static_data_ + other.size_, dynamic_data_->data_.begin());
-  } else {
-    return dynamic_data_->data_ == other.dynamic_data_->data_;
+buffer &buffer::operator=(buffer &&other) noexcept {
+  if (this == &other) {
+    return *this;
   }
+  this->~buffer();
+  steal(other);
+  return *this;
+}
+
+bool buffer::operator==(buffer const &other) const {
+  return size_ == other.size_ && limbs_mismatch(data(), other.data(), size_) == 0;
 }
 
 void buffer::push_back(uint32_t val) {
@@ -127,18 +140,39 @@ size_t buffer::size() const {
   return size_;
 }
 
+size_t buffer::capacity() const {
+  if (small_) {
+    return MAX_STATIC_SIZE;
+  }
+  return exclusive() ? dynamic_data_->data_.capacity() : 0;
+}
+
 bool buffer::exclusive() const {
-  return small_ || dynamic_data_->ref_counter == 1;
+  return small_ || dynamic_data_->unique();
 }
 
-void buffer::unshare() {
+void buffer::make_thread_safe() {
   if (!small_) {
-    if (dynamic_data_->ref_counter == 1) {
-      delete(dynamic_data_);
-    } else {
-      dynamic_data_->ref_counter -= 1;
-    }
+    dynamic_data_->thread_safe = true;
+  }
+}
+
+void buffer::unshare() {
+  if (!small_ && dynamic_data_->release()) {
+    delete(dynamic_data_);
+  }
+}
+
+void buffer::steal(buffer &other) noexcept {
+  size_ = other.size_;
+  small_ = other.small_;
+  if (small_) {
+    std::copy(other.static_data_, other.static_data_ + size_, static_data_);
+  } else {
+    dynamic_data_ = other.dynamic_data_;
   }
+  other.size_ = 0;
+  other.small_ = true;
 }
 
 void buffer::alloc_dynamic_data(size_t size, uint32_t val) {
@@ -8,6 +8,7 @@
 struct buffer {
   explicit buffer(size_t size, uint32_t val = 0);
   buffer(buffer const& other);
+  buffer(buffer&& other) noexcept;
 
   ~buffer();
 
@@ -15,7 +16,12 @@ struct buffer {
   uint32_t const& operator[](size_t index) const;
   uint32_t const& back() const;
 
+  // Unshares the data once, the pointer stays valid until the size changes
+  uint32_t* data();
+  uint32_t const* data() const;
+
   buffer& operator=(buffer const& other);
+  buffer& operator=(buffer&& other) noexcept;
 
   void resize(size_t new_size, uint32_t c = 0);
   void push_back(uint32_t val);
@@ -24,13 +30,19 @@ struct buffer {
   void reserve(size_t new_capacity);
 
   size_t size() const;
+  // Number of limbs that can be written without allocating, 0 if the data is shared
+  size_t capacity() const;
 
   bool exclusive() const;
+  // Switches the shared data to atomic reference counting.
+  // Must be called before copies are made from other threads.
+  void make_thread_safe();
 
   bool operator==(buffer const& other) const;
 
  private:
   void unshare();
+  void steal(buffer& other) noexcept;
   void alloc_dynamic_data(size_t size, uint32_t val);
   void realloc_dynamic_data(size_t size, uint32_t val);
   void alloc_dynamic_data();
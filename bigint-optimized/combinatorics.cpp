@@ -0,0 +1,102 @@
+#include "combinatorics.h"
+
+#include <vector>
+
+namespace {
+
+std::vector<uint32_t> primes_up_to(uint32_t n) {
+  std::vector<uint32_t> primes;
+  std::vector<bool> composite(static_cast<size_t>(n) + 1);
+  for (uint64_t p = 2; p <= n; ++p) {
+    if (!composite[p]) {
+      primes.push_back(static_cast<uint32_t>(p));
+      for (uint64_t q = p * p; q <= n; q += p) {
+        composite[q] = true;
+      }
+    }
+  }
+  return primes;
+}
+
+big_integer product(std::vector<uint32_t> const &words, size_t lo, size_t hi) {
+  if (hi - lo == 1) {
+    return big_integer(static_cast<uint64_t>(words[lo]));
+  }
+  size_t const mid = lo + (hi - lo) / 2;
+  return product(words, lo, mid) * product(words, mid, hi);
+}
+
+// Product tree over the factors packed into as few limbs as possible
+big_integer product(std::vector<uint32_t> const &factors) {
+  std::vector<uint32_t> words;
+  uint64_t cur = 1;
+  for (uint32_t f : factors) {
+    if (cur * f > UINT32_MAX) {
+      words.push_back(static_cast<uint32_t>(cur));
+      cur = 1;
+    }
+    cur *= f;
+  }
+  words.push_back(static_cast<uint32_t>(cur));
+  return product(words, 0, words.size());
+}
+
+// Exponent of p in n!
+uint32_t legendre(uint32_t n, uint32_t p) {
+  uint32_t e = 0;
+  for (; n != 0; n /= p) {
+    e += n / p;
+  }
+  return e;
+}
+
+// Product of primes[i]^exponents[i], by the bits of the exponents from the top: the result is squared and then
+// multiplied by the product of the primes whose exponent has the current bit set
+big_integer prime_power_product(std::vector<uint32_t> const &primes, std::vector<uint32_t> const &exponents) {
+  uint32_t max_exponent = 0;
+  for (uint32_t e : exponents) {
+    max_exponent = std::max(max_exponent, e);
+  }
+  big_integer res = 1;
+  for (uint32_t bit = 1u << 31u; bit != 0; bit >>= 1u) {
+    if (bit > max_exponent) {
+      continue;
+    }
+    res *= res;
+    std::vector<uint32_t> selected;
+    for (size_t i = 0; i < primes.size(); ++i) {
+      if ((exponents[i] & bit) != 0) {
+        selected.push_back(primes[i]);
+      }
+    }
+    res *= product(selected);
+  }
+  return res;
+}
+
+}
+
+big_integer factorial(uint32_t n) {
+  std::vector<uint32_t> const primes = primes_up_to(n);
+  std::vector<uint32_t> exponents(primes.size());
+  for (size_t i = 0; i < primes.size(); ++i) {
+    exponents[i] = legendre(n, primes[i]);
+  }
+  return prime_power_product(primes, exponents);
+}
+
+big_integer binomial(uint32_t n, uint32_t k) {
+  if (k > n) {
+    return 0;
+  }
+  std::vector<uint32_t> const primes = primes_up_to(n);
+  std::vector<uint32_t> exponents(primes.size());
+  for (size_t i = 0; i < primes.size(); ++i) {
+    exponents[i] = legendre(n, primes[i]) - legendre(k, primes[i]) - legendre(n - k, primes[i]);
+  }
+  return prime_power_product(primes, exponents);
+}
+
+big_integer primorial(uint32_t n) {
+  return product(primes_up_to(n));
+}
@@ -0,0 +1,17 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_COMBINATORICS_H_
+#define BIGINT_BIGINT_OPTIMIZED_COMBINATORICS_H_
+
+#include <cstdint>
+#include "big_integer.h"
+
+// Computed from prime factorizations with balanced product trees, so the work goes into multiplications of
+// operands of similar size rather than into long-times-one-limb steps.
+
+// n!
+big_integer factorial(uint32_t n);
+// n! / (k! (n - k)!), 0 for k > n
+big_integer binomial(uint32_t n, uint32_t k);
+// Product of the primes not exceeding n
+big_integer primorial(uint32_t n);
+
+#endif // BIGINT_BIGINT_OPTIMIZED_COMBINATORICS_H_
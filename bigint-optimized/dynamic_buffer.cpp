@@ -1,8 +1,29 @@
 #include "dynamic_buffer.h"
 
 dynamic_buffer::dynamic_buffer(size_t size, uint32_t val)
-    : data_(size, val), ref_counter(1) {}
+    : data_(size, val), ref_counter(1), thread_safe(false) {}
 dynamic_buffer::dynamic_buffer(dynamic_buffer const &other)
-    : data_(other.data_), ref_counter(1) {}
+    : data_(other.data_), ref_counter(1), thread_safe(false) {}
 dynamic_buffer::dynamic_buffer(uint32_t *static_data_, size_t size)
-    : data_(static_data_, static_data_ + size), ref_counter(1) {}
\ No newline at end of file
+    : data_(static_data_, static_data_ + size), ref_counter(1), thread_safe(false) {}
+
+void dynamic_buffer::acquire() {
+  if (thread_safe) {
+    ref_counter.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    ref_counter.store(ref_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+}
+
+bool dynamic_buffer::release() {
+  if (thread_safe) {
+    return ref_counter.fetch_sub(1, std::memory_order_acq_rel) == 1;
+  }
+  size_t refs = ref_counter.load(std::memory_order_relaxed);
+  ref_counter.store(refs - 1, std::memory_order_relaxed);
+  return refs == 1;
+}
+
+bool dynamic_buffer::unique() const {
+  return ref_counter.load(thread_safe ? std::memory_order_acquire : std::memory_order_relaxed) == 1;
+}
@@ -1,16 +1,26 @@
 #ifndef BIGINT_BIGINT_OPTIMIZED_DYNAMIC_BUFFER_H_
 #define BIGINT_BIGINT_OPTIMIZED_DYNAMIC_BUFFER_H_
 
+#include <atomic>
+#include <cstddef>
 #include <vector>
 #include <cstdint>
 
 struct dynamic_buffer {
   std::vector<uint32_t> data_;
-  size_t ref_counter;
+  std::atomic<size_t> ref_counter;
+  // Set once before the buffer is handed to other threads, never cleared.
+  // While it is false the counter is updated with plain loads and stores.
+  bool thread_safe;
 
   explicit dynamic_buffer(size_t size, uint32_t val = 0);
   dynamic_buffer(dynamic_buffer const& other);
   dynamic_buffer(uint32_t* static_data_, size_t size);
+
+  void acquire();
+  // Returns true if the caller has dropped the last reference
+  bool release();
+  bool unique() const;
 };
 
 #endif //BIGINT_BIGINT_OPTIMIZED_DYNAMIC_BUFFER_H_
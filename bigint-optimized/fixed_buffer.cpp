@@ -0,0 +1,99 @@
+#include "fixed_buffer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+fixed_buffer::fixed_buffer(size_t size, uint32_t val) : size_(0) {
+  resize(size, val);
+}
+
+fixed_buffer::fixed_buffer(fixed_buffer const &other) : size_(other.size_) {
+  std::copy(other.data_, other.data_ + size_, data_);
+}
+
+fixed_buffer &fixed_buffer::operator=(fixed_buffer const &other) {
+  if (this != &other) {
+    size_ = other.size_;
+    std::copy(other.data_, other.data_ + size_, data_);
+  }
+  return *this;
+}
+
+void fixed_buffer::swap(fixed_buffer &other) noexcept {
+  fixed_buffer &longer = size_ < other.size_ ? other : *this;
+  fixed_buffer &shorter = size_ < other.size_ ? *this : other;
+  if (&longer != &shorter) {
+    std::swap_ranges(shorter.data_, shorter.data_ + shorter.size_, longer.data_);
+    std::copy(longer.data_ + shorter.size_, longer.data_ + longer.size_, shorter.data_ + shorter.size_);
+    std::swap(size_, other.size_);
+  }
+}
+
+void swap(fixed_buffer &a, fixed_buffer &b) noexcept {
+  a.swap(b);
+}
+
+uint32_t &fixed_buffer::operator[](size_t index) {
+  return data_[index];
+}
+
+uint32_t const &fixed_buffer::operator[](size_t index) const {
+  return data_[index];
+}
+
+uint32_t const &fixed_buffer::back() const {
+  return data_[size_ - 1];
+}
+
+uint32_t *fixed_buffer::data() {
+  return data_;
+}
+
+uint32_t const *fixed_buffer::data() const {
+  return data_;
+}
+
+void fixed_buffer::resize(size_t new_size, uint32_t val) {
+  reserve(new_size);
+  if (size_ < new_size) {
+    std::fill(data_ + size_, data_ + new_size, val);
+  }
+  size_ = new_size;
+}
+
+void fixed_buffer::push_back(uint32_t val) {
+  reserve(size_ + 1);
+  data_[size_++] = val;
+}
+
+void fixed_buffer::pop_back() {
+  --size_;
+}
+
+void fixed_buffer::clear() {
+  size_ = 0;
+}
+
+void fixed_buffer::reserve(size_t new_capacity) {
+  if (new_capacity > CAPACITY) {
+    throw std::length_error("fixed_buffer capacity exceeded");
+  }
+}
+
+size_t fixed_buffer::size() const {
+  return size_;
+}
+
+size_t fixed_buffer::capacity() const {
+  return CAPACITY;
+}
+
+bool fixed_buffer::exclusive() const {
+  return true;
+}
+
+void fixed_buffer::make_thread_safe() {}
+
+bool fixed_buffer::operator==(fixed_buffer const &other) const {
+  return size_ == other.size_ && std::equal(data_, data_ + size_, other.data_);
+}
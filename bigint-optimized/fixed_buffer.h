@@ -0,0 +1,50 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_FIXED_BUFFER_H_
+#define BIGINT_BIGINT_OPTIMIZED_FIXED_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BIGINT_FIXED_CAPACITY
+#define BIGINT_FIXED_CAPACITY 1024
+#endif
+
+// Inline storage of BIGINT_FIXED_CAPACITY limbs, never allocates.
+// Growing past the capacity throws std::length_error.
+// Copies and swaps touch only the limbs in use, not the whole capacity.
+struct fixed_buffer {
+  explicit fixed_buffer(size_t size, uint32_t val = 0);
+  fixed_buffer(fixed_buffer const& other);
+  fixed_buffer& operator=(fixed_buffer const& other);
+  void swap(fixed_buffer& other) noexcept;
+
+  uint32_t& operator[](size_t index);
+  uint32_t const& operator[](size_t index) const;
+  uint32_t const& back() const;
+
+  uint32_t* data();
+  uint32_t const* data() const;
+
+  void resize(size_t new_size, uint32_t c = 0);
+  void push_back(uint32_t val);
+  void pop_back();
+  void clear();
+  void reserve(size_t new_capacity);
+
+  size_t size() const;
+  size_t capacity() const;
+
+  bool exclusive() const;
+  void make_thread_safe();
+
+  bool operator==(fixed_buffer const& other) const;
+
+ private:
+  static const size_t CAPACITY = BIGINT_FIXED_CAPACITY;
+
+  size_t size_;
+  uint32_t data_[CAPACITY];
+};
+
+void swap(fixed_buffer& a, fixed_buffer& b) noexcept;
+
+#endif //BIGINT_BIGINT_OPTIMIZED_FIXED_BUFFER_H_
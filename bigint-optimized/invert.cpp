@@ -0,0 +1,43 @@
+#include "invert.h"
+
+#include "barrett.h"
+
+big_integer invert(big_integer const &a, big_integer const &m) {
+  if (m == 0) {
+    throw std::runtime_error("division by zero");
+  }
+  big_integer const modulus = m < 0 ? -m : m;
+  big_integer s, t;
+  if (gcdext(a, modulus, s, t) != 1) {
+    throw std::runtime_error("not invertible");
+  }
+  if (modulus == 1) {
+    return 0;
+  }
+  s %= modulus;
+  return s < 0 ? s += modulus : s;
+}
+
+std::vector<big_integer> batch_invert(std::vector<big_integer> const &a, big_integer const &m) {
+  if (m == 0) {
+    throw std::runtime_error("division by zero");
+  }
+  std::vector<big_integer> res(a.size());
+  if (a.empty()) {
+    return res;
+  }
+  barrett_context const ctx(m < 0 ? -m : m);
+  // res[i] = a[0] * ... * a[i] mod m
+  res[0] = ctx.reduce(a[0]);
+  for (size_t i = 1; i < a.size(); ++i) {
+    res[i] = ctx.multiply(res[i - 1], ctx.reduce(a[i]));
+  }
+  // inv = (a[0] * ... * a[i])^-1 at step i
+  big_integer inv = invert(res.back(), ctx.modulus());
+  for (size_t i = a.size() - 1; i > 0; --i) {
+    res[i] = ctx.multiply(inv, res[i - 1]);
+    inv = ctx.multiply(inv, ctx.reduce(a[i]));
+  }
+  res[0] = inv;
+  return res;
+}
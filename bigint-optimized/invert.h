@@ -0,0 +1,14 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_INVERT_H_
+#define BIGINT_BIGINT_OPTIMIZED_INVERT_H_
+
+#include <vector>
+#include "big_integer.h"
+
+// a^-1 mod |m| in [0, |m|). Throws std::runtime_error for m = 0 or gcd(a, m) != 1.
+big_integer invert(big_integer const &a, big_integer const &m);
+
+// Inverses of every element modulo |m| with one inversion and 3(n - 1) modular multiplications (Montgomery's
+// trick). Throws std::runtime_error like invert if any element is not invertible.
+std::vector<big_integer> batch_invert(std::vector<big_integer> const &a, big_integer const &m);
+
+#endif // BIGINT_BIGINT_OPTIMIZED_INVERT_H_
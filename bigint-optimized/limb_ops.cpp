@@ -0,0 +1,579 @@
+#include "limb_ops.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BIGINT_LIMB_OPS_X86
+#include <immintrin.h>
+#if defined(__x86_64__)
+#define BIGINT_LIMB_OPS_X86_64
+#endif
+#endif
+
+namespace {
+
+typedef size_t (*mismatch_fn)(uint32_t const *, uint32_t const *, size_t);
+typedef uint32_t (*limb_1_fn)(uint32_t *, uint32_t const *, size_t, uint32_t);
+typedef uint32_t (*limbs_n_fn)(uint32_t *, uint32_t const *, uint32_t const *, size_t);
+typedef uint32_t (*mod_1_fn)(uint32_t const *, size_t, uint32_t);
+typedef void (*mod_1_many_fn)(uint32_t *, uint32_t const *, size_t, uint32_t const *, size_t);
+
+//-------------------------------------------------------Portable-------------------------------------------------------
+
+struct and_op {
+  static uint32_t apply(uint32_t a, uint32_t b) {
+    return a & b;
+  }
+#ifdef BIGINT_LIMB_OPS_X86
+  __attribute__((target("sse2"))) static __m128i apply(__m128i a, __m128i b) {
+    return _mm_and_si128(a, b);
+  }
+  __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+    return _mm256_and_si256(a, b);
+  }
+#endif
+};
+
+struct or_op {
+  static uint32_t apply(uint32_t a, uint32_t b) {
+    return a | b;
+  }
+#ifdef BIGINT_LIMB_OPS_X86
+  __attribute__((target("sse2"))) static __m128i apply(__m128i a, __m128i b) {
+    return _mm_or_si128(a, b);
+  }
+  __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+    return _mm256_or_si256(a, b);
+  }
+#endif
+};
+
+struct xor_op {
+  static uint32_t apply(uint32_t a, uint32_t b) {
+    return a ^ b;
+  }
+#ifdef BIGINT_LIMB_OPS_X86
+  __attribute__((target("sse2"))) static __m128i apply(__m128i a, __m128i b) {
+    return _mm_xor_si128(a, b);
+  }
+  __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b) {
+    return _mm256_xor_si256(a, b);
+  }
+#endif
+};
+
+template <typename Op>
+void bitwise_generic(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+                     uint32_t a_mask, uint32_t b_mask, uint32_t r_mask) {
+  for (size_t i = 0; i < n; ++i) {
+    r[i] = Op::apply(a[i] ^ a_mask, b[i] ^ b_mask) ^ r_mask;
+  }
+}
+
+size_t mismatch_generic(uint32_t const *a, uint32_t const *b, size_t n) {
+  while (n > 0 && a[n - 1] == b[n - 1]) {
+    --n;
+  }
+  return n;
+}
+
+uint32_t mul_1_generic(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    carry += static_cast<uint64_t>(a[i]) * b;
+    r[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+uint32_t addmul_1_generic(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    carry += static_cast<uint64_t>(a[i]) * b + r[i];
+    r[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+uint32_t submul_1_generic(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t const product = static_cast<uint64_t>(a[i]) * b + borrow;
+    uint32_t const low = static_cast<uint32_t>(product);
+    borrow = (product >> 32u) + (r[i] < low ? 1 : 0);
+    r[i] -= low;
+  }
+  return static_cast<uint32_t>(borrow);
+}
+
+uint32_t add_n_generic(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    carry += static_cast<uint64_t>(a[i]) + b[i];
+    r[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+uint32_t sub_n_generic(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t const diff = static_cast<uint64_t>(a[i]) - b[i] - borrow;
+    r[i] = static_cast<uint32_t>(diff);
+    borrow = diff >> 63u;
+  }
+  return static_cast<uint32_t>(borrow);
+}
+
+uint32_t divrem_1_generic(uint32_t *r, uint32_t const *a, size_t n, uint32_t d) {
+  uint64_t rem = 0;
+  for (size_t i = n; i > 0; --i) {
+    uint64_t const cur = (rem << 32u) | a[i - 1];
+    r[i - 1] = static_cast<uint32_t>(cur / d);
+    rem = cur % d;
+  }
+  return static_cast<uint32_t>(rem);
+}
+
+uint32_t mod_1_generic(uint32_t const *a, size_t n, uint32_t d) {
+  uint64_t rem = 0;
+  for (size_t i = n; i > 0; --i) {
+    rem = ((rem << 32u) | a[i - 1]) % d;
+  }
+  return static_cast<uint32_t>(rem);
+}
+
+void mod_1_many_generic(uint32_t *r, uint32_t const *a, size_t n, uint32_t const *d, size_t k) {
+  std::fill(r, r + k, 0);
+  for (size_t i = n; i > 0; --i) {
+    uint64_t const limb = a[i - 1];
+    // the k divisions are independent and overlap in the pipeline
+    for (size_t j = 0; j < k; ++j) {
+      r[j] = static_cast<uint32_t>(((static_cast<uint64_t>(r[j]) << 32u) | limb) % d[j]);
+    }
+  }
+}
+
+//---------------------------------------------------------SSE2---------------------------------------------------------
+
+#ifdef BIGINT_LIMB_OPS_X86
+template <typename Op>
+__attribute__((target("sse2")))
+void bitwise_sse2(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+                  uint32_t a_mask, uint32_t b_mask, uint32_t r_mask) {
+  __m128i const am = _mm_set1_epi32(static_cast<int>(a_mask));
+  __m128i const bm = _mm_set1_epi32(static_cast<int>(b_mask));
+  __m128i const rm = _mm_set1_epi32(static_cast<int>(r_mask));
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(a + i)), am);
+    __m128i y = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(b + i)), bm);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(r + i), _mm_xor_si128(Op::apply(x, y), rm));
+  }
+  bitwise_generic<Op>(r + i, a + i, b + i, n - i, a_mask, b_mask, r_mask);
+}
+
+__attribute__((target("sse2")))
+size_t mismatch_sse2(uint32_t const *a, uint32_t const *b, size_t n) {
+  for (; n >= 4; n -= 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(a + n - 4));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<__m128i const *>(b + n - 4));
+    unsigned differ = ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, y)))) & 0xFu;
+    if (differ != 0) {
+      return n - 4 + (32 - static_cast<size_t>(__builtin_clz(differ)));
+    }
+  }
+  return mismatch_generic(a, b, n);
+}
+
+//---------------------------------------------------------AVX2---------------------------------------------------------
+
+template <typename Op>
+__attribute__((target("avx2")))
+void bitwise_avx2(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+                  uint32_t a_mask, uint32_t b_mask, uint32_t r_mask) {
+  __m256i const am = _mm256_set1_epi32(static_cast<int>(a_mask));
+  __m256i const bm = _mm256_set1_epi32(static_cast<int>(b_mask));
+  __m256i const rm = _mm256_set1_epi32(static_cast<int>(r_mask));
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + i)), am);
+    __m256i y = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + i)), bm);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(r + i), _mm256_xor_si256(Op::apply(x, y), rm));
+  }
+  bitwise_generic<Op>(r + i, a + i, b + i, n - i, a_mask, b_mask, r_mask);
+}
+
+__attribute__((target("avx2")))
+size_t mismatch_avx2(uint32_t const *a, uint32_t const *b, size_t n) {
+  for (; n >= 8; n -= 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(a + n - 8));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(b + n - 8));
+    unsigned differ = ~static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, y)))) & 0xFFu;
+    if (differ != 0) {
+      return n - 8 + (32 - static_cast<size_t>(__builtin_clz(differ)));
+    }
+  }
+  return mismatch_generic(a, b, n);
+}
+#endif
+
+//-------------------------------------------------------BMI2-ADX-------------------------------------------------------
+
+// Pairs of limbs are handled as one 64-bit word. MULX multiplies a word by the 32-bit limb without touching the
+// flags, so the accumulating kernels run two carry chains at once: ADCX uses only the carry flag and ADOX only the
+// overflow flag, and the loop counter is stepped with LEA and JRCXZ, which leave both alone. addmul_1 adds the
+// previous high half to the product on one chain and the product to r on the other; submul_1 does the same with
+// r + ~x + 1 in place of r - x, since SBB would clobber the overflow flag. Compilers lower _addcarryx_u64 to plain
+// ADC and serialize the two chains through saved flags, hence the inline assembly.
+// A word times a 32-bit limb has a high half below 2^32, so the carry out is again one limb.
+#ifdef BIGINT_LIMB_OPS_X86_64
+__attribute__((target("bmi2")))
+uint32_t mul_1_bmi2(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  unsigned long long carry = 0;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    unsigned long long x, hi;
+    std::memcpy(&x, a + i, sizeof(x));
+    unsigned long long lo = _mulx_u64(x, b, &hi);
+    carry = hi + _addcarry_u64(0, lo, carry, &lo);
+    std::memcpy(r + i, &lo, sizeof(lo));
+  }
+  if (i < n) {
+    carry += static_cast<uint64_t>(a[i]) * b;
+    r[i] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+uint32_t addmul_1_adx(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  unsigned long long words = n / 2, carry = 0, lo, hi;
+  uint32_t *rp = r;
+  uint32_t const *ap = a;
+  if (words != 0) {
+    __asm__(
+        "xor %k[lo], %k[lo]\n\t"
+        "1:\n\t"
+        "mulx (%[a]), %[lo], %[hi]\n\t"
+        "adcx %[carry], %[lo]\n\t"
+        "adox (%[r]), %[lo]\n\t"
+        "mov %[lo], (%[r])\n\t"
+        "mov %[hi], %[carry]\n\t"
+        "lea 8(%[a]), %[a]\n\t"
+        "lea 8(%[r]), %[r]\n\t"
+        "lea -1(%[n]), %[n]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n"
+        "2:\n\t"
+        "mov $0, %k[lo]\n\t"
+        "adcx %[lo], %[carry]\n\t"
+        "adox %[lo], %[carry]\n\t"
+        : [a] "+r"(ap), [r] "+r"(rp), [n] "+c"(words), [carry] "+r"(carry), [lo] "=&r"(lo), [hi] "=&r"(hi)
+        : "d"(static_cast<unsigned long long>(b))
+        : "cc", "memory");
+  }
+  if (n % 2 != 0) {
+    carry += static_cast<uint64_t>(a[n - 1]) * b + r[n - 1];
+    r[n - 1] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+uint32_t submul_1_adx(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  // cf ends up as the carry of r + ~x + 1, that is 1 when nothing was borrowed
+  unsigned long long words = n / 2, carry = 0, lo, hi, cf = 1;
+  uint32_t *rp = r;
+  uint32_t const *ap = a;
+  if (words != 0) {
+    __asm__(
+        "xor %k[lo], %k[lo]\n\t"
+        "stc\n"
+        "1:\n\t"
+        "mulx (%[a]), %[lo], %[hi]\n\t"
+        "adox %[carry], %[lo]\n\t"
+        "mov %[hi], %[carry]\n\t"
+        "not %[lo]\n\t"
+        "adcx (%[r]), %[lo]\n\t"
+        "mov %[lo], (%[r])\n\t"
+        "lea 8(%[a]), %[a]\n\t"
+        "lea 8(%[r]), %[r]\n\t"
+        "lea -1(%[n]), %[n]\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n"
+        "2:\n\t"
+        "mov $0, %k[lo]\n\t"
+        "adox %[lo], %[carry]\n\t"
+        "mov $0, %k[cf]\n\t"
+        "adcx %[lo], %[cf]\n\t"
+        : [a] "+r"(ap), [r] "+r"(rp), [n] "+c"(words), [carry] "+r"(carry), [lo] "=&r"(lo), [hi] "=&r"(hi),
+          [cf] "+r"(cf)
+        : "d"(static_cast<unsigned long long>(b))
+        : "cc", "memory");
+  }
+  uint64_t borrow = carry + 1 - cf;
+  if (n % 2 != 0) {
+    uint64_t const product = static_cast<uint64_t>(a[n - 1]) * b + borrow;
+    uint32_t const low = static_cast<uint32_t>(product);
+    borrow = (product >> 32u) + (r[n - 1] < low ? 1 : 0);
+    r[n - 1] -= low;
+  }
+  return static_cast<uint32_t>(borrow);
+}
+
+//--------------------------------------------------------x86-64--------------------------------------------------------
+
+// One ADC/SBB chain over pairs of limbs, which any x86-64 CPU has
+uint32_t add_n_x86_64(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n) {
+  unsigned char cf = 0;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    unsigned long long x, y;
+    std::memcpy(&x, a + i, sizeof(x));
+    std::memcpy(&y, b + i, sizeof(y));
+    cf = _addcarry_u64(cf, x, y, &x);
+    std::memcpy(r + i, &x, sizeof(x));
+  }
+  uint32_t carry = cf;
+  if (i < n) {
+    uint64_t const sum = static_cast<uint64_t>(a[i]) + b[i] + carry;
+    r[i] = static_cast<uint32_t>(sum);
+    carry = static_cast<uint32_t>(sum >> 32u);
+  }
+  return carry;
+}
+
+uint32_t sub_n_x86_64(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n) {
+  unsigned char bf = 0;
+  size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    unsigned long long x, y;
+    std::memcpy(&x, a + i, sizeof(x));
+    std::memcpy(&y, b + i, sizeof(y));
+    bf = _subborrow_u64(bf, x, y, &x);
+    std::memcpy(r + i, &x, sizeof(x));
+  }
+  uint32_t borrow = bf;
+  if (i < n) {
+    uint64_t const diff = static_cast<uint64_t>(a[i]) - b[i] - borrow;
+    r[i] = static_cast<uint32_t>(diff);
+    borrow = static_cast<uint32_t>(diff >> 63u);
+  }
+  return borrow;
+}
+#endif
+
+//-------------------------------------------------------Registry-------------------------------------------------------
+
+bool allowed_isa(char const *allowed, char const *isa) {
+  if (allowed == nullptr) {
+    return true;
+  }
+  std::string const list = allowed;
+  size_t begin = 0;
+  while (begin <= list.size()) {
+    size_t end = list.find(',', begin);
+    if (end == std::string::npos) {
+      end = list.size();
+    }
+    size_t first = list.find_first_not_of(' ', begin), last = list.find_last_not_of(' ', end - 1);
+    if (first < end && last != std::string::npos && list.compare(first, last - first + 1, isa) == 0) {
+      return true;
+    }
+    begin = end + 1;
+  }
+  return false;
+}
+
+struct limb_kernels_table {
+  char const *vector_isa;
+  limbs_bitwise_fn and_;
+  limbs_bitwise_fn or_;
+  limbs_bitwise_fn xor_;
+  mismatch_fn mismatch;
+  char const *carry_isa;
+  limb_1_fn mul_1;
+  limb_1_fn addmul_1;
+  limb_1_fn submul_1;
+  char const *add_isa;
+  limbs_n_fn add_n;
+  limbs_n_fn sub_n;
+  limb_1_fn divrem_1;
+  mod_1_fn mod_1;
+  mod_1_many_fn mod_1_many;
+
+  explicit limb_kernels_table(char const *allowed)
+      : vector_isa("generic"),
+        and_(bitwise_generic<and_op>),
+        or_(bitwise_generic<or_op>),
+        xor_(bitwise_generic<xor_op>),
+        mismatch(mismatch_generic),
+        carry_isa("generic"),
+        mul_1(mul_1_generic),
+        addmul_1(addmul_1_generic),
+        submul_1(submul_1_generic),
+        add_isa("generic"),
+        add_n(add_n_generic),
+        sub_n(sub_n_generic),
+        divrem_1(divrem_1_generic),
+        mod_1(mod_1_generic),
+        mod_1_many(mod_1_many_generic) {
+#ifdef BIGINT_LIMB_OPS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && allowed_isa(allowed, "avx2")) {
+      vector_isa = "avx2";
+      and_ = bitwise_avx2<and_op>;
+      or_ = bitwise_avx2<or_op>;
+      xor_ = bitwise_avx2<xor_op>;
+      mismatch = mismatch_avx2;
+    } else if (__builtin_cpu_supports("sse2") && allowed_isa(allowed, "sse2")) {
+      vector_isa = "sse2";
+      and_ = bitwise_sse2<and_op>;
+      or_ = bitwise_sse2<or_op>;
+      xor_ = bitwise_sse2<xor_op>;
+      mismatch = mismatch_sse2;
+    }
+#endif
+#ifdef BIGINT_LIMB_OPS_X86_64
+    if (__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx") && allowed_isa(allowed, "bmi2-adx")) {
+      carry_isa = "bmi2-adx";
+      mul_1 = mul_1_bmi2;
+      addmul_1 = addmul_1_adx;
+      submul_1 = submul_1_adx;
+    }
+    if (allowed_isa(allowed, "x86-64")) {
+      add_isa = "x86-64";
+      add_n = add_n_x86_64;
+      sub_n = sub_n_x86_64;
+    }
+#endif
+  }
+};
+
+limb_kernels_table &table() {
+  static limb_kernels_table instance(std::getenv("BIGINT_KERNELS"));
+  return instance;
+}
+
+}
+
+void limb_kernels_select(char const *allowed) {
+  table() = limb_kernels_table(allowed);
+}
+
+char const *limb_kernel_isa(char const *kernel) {
+  static char const *const vector_kernels[] = {"and", "or", "xor", "mismatch"};
+  static char const *const carry_kernels[] = {"mul_1", "addmul_1", "submul_1"};
+  static char const *const add_kernels[] = {"add_n", "sub_n"};
+  for (char const *name : vector_kernels) {
+    if (std::strcmp(name, kernel) == 0) {
+      return table().vector_isa;
+    }
+  }
+  for (char const *name : carry_kernels) {
+    if (std::strcmp(name, kernel) == 0) {
+      return table().carry_isa;
+    }
+  }
+  for (char const *name : add_kernels) {
+    if (std::strcmp(name, kernel) == 0) {
+      return table().add_isa;
+    }
+  }
+  static char const *const portable_kernels[] = {"divrem_1", "mod_1", "mod_1_many"};
+  for (char const *name : portable_kernels) {
+    if (std::strcmp(name, kernel) == 0) {
+      return "generic";
+    }
+  }
+  return nullptr;
+}
+
+void limbs_and(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+               uint32_t a_mask, uint32_t b_mask, uint32_t r_mask) {
+  table().and_(r, a, b, n, a_mask, b_mask, r_mask);
+}
+
+void limbs_or(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+              uint32_t a_mask, uint32_t b_mask, uint32_t r_mask) {
+  table().or_(r, a, b, n, a_mask, b_mask, r_mask);
+}
+
+void limbs_xor(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+               uint32_t a_mask, uint32_t b_mask, uint32_t r_mask) {
+  table().xor_(r, a, b, n, a_mask, b_mask, r_mask);
+}
+
+size_t limbs_mismatch(uint32_t const *a, uint32_t const *b, size_t n) {
+  return table().mismatch(a, b, n);
+}
+
+uint32_t limbs_mul_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  return table().mul_1(r, a, n, b);
+}
+
+uint32_t limbs_addmul_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  return table().addmul_1(r, a, n, b);
+}
+
+uint32_t limbs_submul_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t b) {
+  return table().submul_1(r, a, n, b);
+}
+
+uint32_t limbs_add_n(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n) {
+  return table().add_n(r, a, b, n);
+}
+
+uint32_t limbs_sub_n(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n) {
+  return table().sub_n(r, a, b, n);
+}
+
+uint32_t limbs_divrem_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t d) {
+  return table().divrem_1(r, a, n, d);
+}
+
+uint32_t limbs_mod_1(uint32_t const *a, size_t n, uint32_t d) {
+  return table().mod_1(a, n, d);
+}
+
+void limbs_mod_1_many(uint32_t *r, uint32_t const *a, size_t n, uint32_t const *d, size_t k) {
+  table().mod_1_many(r, a, n, d, k);
+}
+
+//-------------------------------------------------------Products-------------------------------------------------------
+
+void limbs_mul(uint32_t *r, uint32_t const *a, size_t n, uint32_t const *b, size_t m) {
+  r[m] = limbs_mul_1(r, b, m, a[0]);
+  for (size_t i = 1; i < n; ++i) {
+    r[i + m] = limbs_addmul_1(r + i, b, m, a[i]);
+  }
+}
+
+void limbs_sqr(uint32_t *r, uint32_t const *a, size_t n) {
+  r[0] = 0;
+  r[2 * n - 1] = 0;
+  if (n > 1) {
+    // a[i] * a[j] for i < j, row i lands at r[2i + 1, i + n]
+    r[n] = limbs_mul_1(r + 1, a + 1, n - 1, a[0]);
+    for (size_t i = 1; i + 1 < n; ++i) {
+      r[i + n] = limbs_addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+    }
+    limbs_add_n(r, r, r, 2 * n);
+  }
+  uint64_t carry = 0;
+  for (size_t i = 0; i < n; ++i) {
+    uint64_t const p = static_cast<uint64_t>(a[i]) * a[i];
+    carry += static_cast<uint64_t>(r[2 * i]) + static_cast<uint32_t>(p);
+    r[2 * i] = static_cast<uint32_t>(carry);
+    carry = (carry >> 32u) + r[2 * i + 1] + (p >> 32u);
+    r[2 * i + 1] = static_cast<uint32_t>(carry);
+    carry >>= 32u;
+  }
+}
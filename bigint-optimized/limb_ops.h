@@ -0,0 +1,59 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_LIMB_OPS_H_
+#define BIGINT_BIGINT_OPTIMIZED_LIMB_OPS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Loops over limbs. Every kernel has a portable implementation and may have AVX2, SSE2, BMI2/ADX or plain x86-64
+// ones; the registry picks one per kernel on first use.
+//
+// The instruction sets the kernels may use are read from the BIGINT_KERNELS environment variable: a comma-separated
+// list of "avx2", "sse2", "bmi2-adx" and "x86-64", where "generic" (or an empty list) forces the portable code.
+// Without the variable everything the CPU reports is used. Instruction sets the CPU lacks are never enabled.
+
+// r[i] = op(a[i] ^ a_mask, b[i] ^ b_mask) ^ r_mask for i < n, r may be equal to a or b
+typedef void (*limbs_bitwise_fn)(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+                                 uint32_t a_mask, uint32_t b_mask, uint32_t r_mask);
+void limbs_and(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+               uint32_t a_mask, uint32_t b_mask, uint32_t r_mask);
+void limbs_or(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+              uint32_t a_mask, uint32_t b_mask, uint32_t r_mask);
+void limbs_xor(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n,
+               uint32_t a_mask, uint32_t b_mask, uint32_t r_mask);
+
+// Returns k such that a[k - 1] != b[k - 1] and a[i] == b[i] for all i >= k, or 0 if the ranges are equal
+size_t limbs_mismatch(uint32_t const *a, uint32_t const *b, size_t n);
+
+// r[i] = a[i] * b + carry for i < n, returns the carry limb; r may be equal to a
+uint32_t limbs_mul_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t b);
+// r[0, n) += a[0, n) * b, returns the carry limb
+uint32_t limbs_addmul_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t b);
+// r[0, n) -= a[0, n) * b, returns the borrow limb
+uint32_t limbs_submul_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t b);
+// r[0, n) = a[0, n) + b[0, n), returns the carry; r may be equal to a or b
+uint32_t limbs_add_n(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n);
+// r[0, n) = a[0, n) - b[0, n), returns the borrow; r may be equal to a or b
+uint32_t limbs_sub_n(uint32_t *r, uint32_t const *a, uint32_t const *b, size_t n);
+// r[0, n) = a[0, n) / d, returns the remainder; r may be equal to a
+uint32_t limbs_divrem_1(uint32_t *r, uint32_t const *a, size_t n, uint32_t d);
+// a[0, n) mod d, no quotient is written
+uint32_t limbs_mod_1(uint32_t const *a, size_t n, uint32_t d);
+// r[j] = a[0, n) mod d[j] for j < k, in one pass over a
+void limbs_mod_1_many(uint32_t *r, uint32_t const *a, size_t n, uint32_t const *d, size_t k);
+
+// Schoolbook products built on the kernels above; r must not overlap the operands
+// r[0, n + m) = a[0, n) * b[0, m), n, m > 0
+void limbs_mul(uint32_t *r, uint32_t const *a, size_t n, uint32_t const *b, size_t m);
+// r[0, 2n) = a[0, n)^2, n > 0; every cross product is computed once
+void limbs_sqr(uint32_t *r, uint32_t const *a, size_t n);
+
+// Selects the kernels again as if BIGINT_KERNELS were set to allowed, nullptr meaning unset.
+// Must not run concurrently with big_integer arithmetic.
+void limb_kernels_select(char const *allowed);
+
+// Implementation used by a kernel ("and", "or", "xor", "mismatch", "mul_1", "addmul_1", "submul_1", "add_n",
+// "sub_n", "divrem_1", "mod_1", "mod_1_many"): "avx2", "sse2", "bmi2-adx", "x86-64" or "generic"; nullptr for an
+// unknown kernel
+char const *limb_kernel_isa(char const *kernel);
+
+#endif //BIGINT_BIGINT_OPTIMIZED_LIMB_OPS_H_
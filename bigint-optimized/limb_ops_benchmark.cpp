@@ -0,0 +1,66 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "limb_ops.h"
+
+// Times every multiply and add kernel with the portable code and with what the registry selects on this CPU.
+// Build with -DCMAKE_BUILD_TYPE=Release.
+
+namespace {
+
+size_t const total_limbs = 200000000;
+
+template <typename F>
+double seconds(F f) {
+  auto const start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename F>
+void compare(char const *kernel, size_t n, F f) {
+  limb_kernels_select("generic");
+  double const generic = seconds(f);
+  limb_kernels_select(std::getenv("BIGINT_KERNELS"));
+  double const selected = seconds(f);
+  std::printf("%-9s %5zu limbs  generic %.3fs  %-8s %.3fs  x%.2f\n",
+              kernel, n, generic, limb_kernel_isa(kernel), selected, generic / selected);
+}
+
+}
+
+int main() {
+  for (size_t n : {16, 64, 256, 4096}) {
+    std::vector<uint32_t> a(n, 0x9e3779b9u), b(n, 0x7f4a7c15u), r(n, 0x12345678u);
+    size_t const reps = total_limbs / n;
+    uint32_t volatile sink = 0;
+    compare("mul_1", n, [&] {
+      for (size_t i = 0; i < reps; ++i) {
+        sink += limbs_mul_1(r.data(), a.data(), n, 0xdeadbeefu + static_cast<uint32_t>(i));
+      }
+    });
+    compare("addmul_1", n, [&] {
+      for (size_t i = 0; i < reps; ++i) {
+        sink += limbs_addmul_1(r.data(), a.data(), n, 0xdeadbeefu + static_cast<uint32_t>(i));
+      }
+    });
+    compare("submul_1", n, [&] {
+      for (size_t i = 0; i < reps; ++i) {
+        sink += limbs_submul_1(r.data(), a.data(), n, 0xdeadbeefu + static_cast<uint32_t>(i));
+      }
+    });
+    compare("add_n", n, [&] {
+      for (size_t i = 0; i < reps; ++i) {
+        sink += limbs_add_n(r.data(), a.data(), b.data(), n);
+      }
+    });
+    compare("sub_n", n, [&] {
+      for (size_t i = 0; i < reps; ++i) {
+        sink += limbs_sub_n(r.data(), a.data(), b.data(), n);
+      }
+    });
+  }
+  return 0;
+}
@@ -0,0 +1,124 @@
+#include "montgomery.h"
+
+#include "sliding_window.h"
+
+namespace {
+
+// a[0, n) >= b[0, n)
+bool limbs_not_less(uint32_t const *a, uint32_t const *b, size_t n) {
+  size_t const k = limbs_mismatch(a, b, n);
+  return k == 0 || a[k - 1] > b[k - 1];
+}
+
+}
+
+montgomery_context::montgomery_context(big_integer const &m) : m_(m), k_(m.size()), m_inv_(0) {
+  if (m.sign_ || m.is_zero() || (m.value_[0] & 1u) == 0) {
+    throw std::runtime_error("montgomery modulus must be odd and positive");
+  }
+  // Newton iteration doubles the number of correct low bits: 3, 6, 12, 24, 48
+  uint32_t const m0 = m.value_[0];
+  uint32_t inv = m0;
+  for (int i = 0; i < 4; ++i) {
+    inv *= 2 - m0 * inv;
+  }
+  m_inv_ = -inv;
+  r2_ = (big_integer(1) << static_cast<int>(64 * k_)) % m_;
+}
+
+big_integer const &montgomery_context::modulus() const {
+  return m_;
+}
+
+big_integer montgomery_context::to_montgomery(big_integer const &a) const {
+  big_integer reduced = a % m_;
+  if (reduced.sign_) {
+    reduced += m_;
+  }
+  return multiply(reduced, r2_);
+}
+
+big_integer montgomery_context::from_montgomery(big_integer const &a) const {
+  limbs_t t(2 * k_ + 1), r(k_);
+  limbs_t const x = to_limbs_(a);
+  std::copy(x.begin(), x.end(), t.begin());
+  redc_(t.data(), r.data());
+  return from_limbs_(r);
+}
+
+big_integer montgomery_context::multiply(big_integer const &a, big_integer const &b) const {
+  limbs_t t(2 * k_ + 1), r(k_);
+  mul_(r.data(), to_limbs_(a).data(), to_limbs_(b).data(), t.data());
+  return from_limbs_(r);
+}
+
+big_integer montgomery_context::square(big_integer const &a) const {
+  limbs_t t(2 * k_ + 1), r(k_);
+  sqr_(r.data(), to_limbs_(a).data(), t.data());
+  return from_limbs_(r);
+}
+
+big_integer montgomery_context::modpow(big_integer const &base, big_integer const &exp) const {
+  return from_montgomery(montgomery_pow(to_montgomery(base), exp));
+}
+
+big_integer montgomery_context::montgomery_pow(big_integer const &base, big_integer const &exp) const {
+  if (exp.sign_) {
+    throw std::runtime_error("negative exponent");
+  }
+  if (exp.is_zero()) {
+    return to_montgomery(1);
+  }
+  limbs_t t(2 * k_ + 1);
+  limbs_t const res = sliding_window_pow(
+      to_limbs_(base), exp.bit_length(),
+      [&exp](size_t i) { return exp.bit(i); },
+      [this, &t](limbs_t &acc, limbs_t const &y) { mul_(acc.data(), acc.data(), y.data(), t.data()); },
+      [this, &t](limbs_t &acc) { sqr_(acc.data(), acc.data(), t.data()); });
+  return from_limbs_(res);
+}
+
+void montgomery_context::redc_(uint32_t *t, uint32_t *r) const {
+  uint32_t const *m = m_.value_.data();
+  for (size_t i = 0; i < k_; ++i) {
+    // makes t[i] zero
+    uint32_t carry = limbs_addmul_1(t + i, m, k_, t[i] * m_inv_);
+    for (size_t j = i + k_; carry != 0; ++j) {
+      uint64_t const sum = static_cast<uint64_t>(t[j]) + carry;
+      t[j] = static_cast<uint32_t>(sum);
+      carry = static_cast<uint32_t>(sum >> 32u);
+    }
+  }
+  // t / R < 2m
+  if (t[2 * k_] != 0 || limbs_not_less(t + k_, m, k_)) {
+    limbs_sub_n(r, t + k_, m, k_);
+  } else {
+    std::copy(t + k_, t + 2 * k_, r);
+  }
+}
+
+void montgomery_context::mul_(uint32_t *r, uint32_t const *a, uint32_t const *b, uint32_t *t) const {
+  limbs_mul(t, a, k_, b, k_);
+  t[2 * k_] = 0;
+  redc_(t, r);
+}
+
+void montgomery_context::sqr_(uint32_t *r, uint32_t const *a, uint32_t *t) const {
+  limbs_sqr(t, a, k_);
+  t[2 * k_] = 0;
+  redc_(t, r);
+}
+
+montgomery_context::limbs_t montgomery_context::to_limbs_(big_integer const &a) const {
+  limbs_t res(k_);
+  storage_t const &v = a.value_;
+  std::copy(v.data(), v.data() + std::min(a.size(), k_), res.begin());
+  return res;
+}
+
+big_integer montgomery_context::from_limbs_(limbs_t const &a) {
+  big_integer res(false, a.size());
+  std::copy(a.begin(), a.end(), res.value_.data());
+  res.to_normal_form();
+  return res;
+}
@@ -0,0 +1,49 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_MONTGOMERY_H_
+#define BIGINT_BIGINT_OPTIMIZED_MONTGOMERY_H_
+
+#include <cstdint>
+#include <vector>
+#include "big_integer.h"
+
+// Arithmetic modulo an odd m > 0 of k limbs in Montgomery form: a is kept as a * R mod m with R = 2^(32k), and a
+// product is reduced by REDC (k multiply-add rows) instead of a division.
+struct montgomery_context {
+  // Throws std::runtime_error unless m is odd and positive
+  explicit montgomery_context(big_integer const &m);
+
+  big_integer const &modulus() const;
+
+  // a * R mod m for any a, and back
+  big_integer to_montgomery(big_integer const &a) const;
+  big_integer from_montgomery(big_integer const &a) const;
+
+  // Operands and results in Montgomery form, operands in [0, m)
+  big_integer multiply(big_integer const &a, big_integer const &b) const;
+  big_integer square(big_integer const &a) const;
+
+  // base^exp mod m for an ordinary base and exp >= 0, the result in [0, m)
+  big_integer modpow(big_integer const &base, big_integer const &exp) const;
+  // The same with base and result in Montgomery form
+  big_integer montgomery_pow(big_integer const &base, big_integer const &exp) const;
+
+ private:
+  big_integer m_;
+  size_t k_;
+  // -m^-1 mod 2^32
+  uint32_t m_inv_;
+  // R^2 mod m
+  big_integer r2_;
+
+  typedef std::vector<uint32_t> limbs_t;
+
+  // t of 2k + 1 limbs, t < m * R, is overwritten; r[0, k) = t / R mod m
+  void redc_(uint32_t *t, uint32_t *r) const;
+  void mul_(uint32_t *r, uint32_t const *a, uint32_t const *b, uint32_t *t) const;
+  void sqr_(uint32_t *r, uint32_t const *a, uint32_t *t) const;
+
+  // a in [0, m) padded to k limbs, and back
+  limbs_t to_limbs_(big_integer const &a) const;
+  static big_integer from_limbs_(limbs_t const &a);
+};
+
+#endif // BIGINT_BIGINT_OPTIMIZED_MONTGOMERY_H_
@@ -0,0 +1,43 @@
+#include "power.h"
+
+#include "barrett.h"
+#include "montgomery.h"
+#include "sliding_window.h"
+
+big_integer pow(big_integer const &base, uint64_t exp) {
+  if (exp == 0) {
+    return 1;
+  }
+  size_t bits = 0;
+  for (uint64_t e = exp; e != 0; e >>= 1u) {
+    ++bits;
+  }
+  return sliding_window_pow(
+      base, bits,
+      [exp](size_t i) { return ((exp >> i) & 1u) != 0; },
+      [](big_integer &acc, big_integer const &y) { acc *= y; },
+      [](big_integer &acc) { acc *= acc; });
+}
+
+big_integer powmod(big_integer const &base, big_integer const &exp, big_integer const &m) {
+  if (m == 0) {
+    throw std::runtime_error("division by zero");
+  }
+  if (exp < 0) {
+    throw std::runtime_error("negative exponent");
+  }
+  big_integer const modulus = m < 0 ? -m : m;
+  if (modulus.bit(0)) {
+    return montgomery_context(modulus).modpow(base, exp);
+  }
+  barrett_context const ctx(modulus);
+  big_integer const x = ctx.reduce(base);
+  if (exp == 0) {
+    return ctx.reduce(1);
+  }
+  return sliding_window_pow(
+      x, exp.bit_length(),
+      [&exp](size_t i) { return exp.bit(i); },
+      [&ctx](big_integer &acc, big_integer const &y) { acc = ctx.multiply(acc, y); },
+      [&ctx](big_integer &acc) { acc = ctx.multiply(acc, acc); });
+}
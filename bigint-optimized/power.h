@@ -0,0 +1,14 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_POWER_H_
+#define BIGINT_BIGINT_OPTIMIZED_POWER_H_
+
+#include <cstdint>
+#include "big_integer.h"
+
+// base^exp, pow(0, 0) = 1
+big_integer pow(big_integer const &base, uint64_t exp);
+
+// base^exp mod |m| in [0, |m|) for exp >= 0: Montgomery reduction for odd m, Barrett reduction otherwise.
+// Throws std::runtime_error for m = 0 or exp < 0.
+big_integer powmod(big_integer const &base, big_integer const &exp, big_integer const &m);
+
+#endif // BIGINT_BIGINT_OPTIMIZED_POWER_H_
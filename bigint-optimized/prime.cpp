@@ -0,0 +1,141 @@
+#include "prime.h"
+
+#include <cmath>
+#include "montgomery.h"
+
+namespace {
+
+// 168 primes, all of those below trial_limit
+uint32_t const trial_limit = 1000;
+size_t const trial_count = 168;
+
+// The first count primes, grouped so that the product of every group fits into a limb
+struct prime_groups {
+  std::vector<uint32_t> primes;
+  std::vector<uint32_t> products;
+  // group j holds primes[ends[j - 1], ends[j])
+  std::vector<size_t> ends;
+
+  explicit prime_groups(size_t count) {
+    // the count-th prime is below count (ln count + ln ln count) for count >= 6
+    double const ln = std::log(static_cast<double>(std::max<size_t>(count, 6)));
+    size_t const bound = static_cast<size_t>(static_cast<double>(std::max<size_t>(count, 6)) * (ln + std::log(ln))) + 1;
+    std::vector<bool> composite(bound + 1);
+    for (size_t p = 2; p <= bound && primes.size() < count; ++p) {
+      if (!composite[p]) {
+        primes.push_back(static_cast<uint32_t>(p));
+        for (size_t q = p * p; q <= bound; q += p) {
+          composite[q] = true;
+        }
+      }
+    }
+    uint64_t product = 1;
+    for (size_t i = 0; i < primes.size(); ++i) {
+      if (product * primes[i] > UINT32_MAX) {
+        products.push_back(static_cast<uint32_t>(product));
+        ends.push_back(i);
+        product = 1;
+      }
+      product *= primes[i];
+    }
+    products.push_back(static_cast<uint32_t>(product));
+    ends.push_back(primes.size());
+  }
+};
+
+// Smallest of groups.primes[0, count) dividing a[0, n)
+uint32_t smallest_prime_factor(uint32_t const *a, size_t n, prime_groups const &groups, size_t count) {
+  size_t k = 0;
+  while (k < groups.ends.size() && (k == 0 || groups.ends[k - 1] < count)) {
+    ++k;
+  }
+  std::vector<uint32_t> rems(k);
+  limbs_mod_1_many(rems.data(), a, n, groups.products.data(), k);
+  size_t i = 0;
+  for (size_t j = 0; j < k; ++j) {
+    for (; i < groups.ends[j] && i < count; ++i) {
+      if (rems[j] % groups.primes[i] == 0) {
+        return groups.primes[i];
+      }
+    }
+  }
+  return 0;
+}
+
+}
+
+uint32_t trial_division(big_integer const &n, size_t count) {
+  static prime_groups const first(trial_count);
+  storage_t const &v = n.value_;
+  if (count <= first.primes.size()) {
+    return smallest_prime_factor(v.data(), n.size(), first, count);
+  }
+  return smallest_prime_factor(v.data(), n.size(), prime_groups(count), count);
+}
+
+namespace {
+
+// n odd, n - 1 = d * 2^s with d odd; everything stays in Montgomery form, one and minus_one included
+struct miller_rabin {
+  montgomery_context ctx;
+  big_integer d;
+  size_t s;
+  big_integer one;
+  big_integer minus_one;
+
+  miller_rabin(big_integer const &n, big_integer const &d, size_t s)
+      : ctx(n), d(d), s(s), one(ctx.to_montgomery(1)), minus_one(ctx.to_montgomery(n - 1)) {}
+
+  bool strong_probable_prime(big_integer const &base) const;
+};
+
+bool miller_rabin::strong_probable_prime(big_integer const &base) const {
+  big_integer x = ctx.montgomery_pow(ctx.to_montgomery(base), d);
+  // a base divisible by n says nothing
+  if (x == one || x == minus_one || x == 0) {
+    return true;
+  }
+  for (size_t i = 1; i < s; ++i) {
+    x = ctx.square(x);
+    if (x == minus_one) {
+      return true;
+    }
+    if (x == one) {
+      return false;
+    }
+  }
+  return false;
+}
+
+}
+
+bool is_probable_prime(big_integer const &n, std::vector<big_integer> const &bases) {
+  if (n < 2) {
+    return false;
+  }
+  uint32_t const p = trial_division(n, trial_count);
+  if (p != 0) {
+    return n == p;
+  }
+  if (n < static_cast<int>(trial_limit * trial_limit)) {
+    return true;
+  }
+  big_integer const n_minus_one = n - 1;
+  size_t s = 0;
+  while (!n_minus_one.bit(s)) {
+    ++s;
+  }
+  big_integer const d = n_minus_one >> static_cast<int>(s);
+  miller_rabin const test(n, d, s);
+  for (big_integer const &base : bases) {
+    if (!test.strong_probable_prime(base)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool is_probable_prime(big_integer const &n) {
+  static std::vector<big_integer> const bases = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41};
+  return is_probable_prime(n, bases);
+}
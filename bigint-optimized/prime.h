@@ -0,0 +1,19 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_PRIME_H_
+#define BIGINT_BIGINT_OPTIMIZED_PRIME_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "big_integer.h"
+
+// Smallest of the first count primes that divides n, 0 if none does. n is reduced in one pass modulo products of
+// primes that fit into a limb, the primes are then checked against those one-limb remainders.
+uint32_t trial_division(big_integer const &n, size_t count);
+
+// Trial division by the primes below 1000, then a strong probable-prime (Miller-Rabin) test to every base, with
+// the powers taken in Montgomery form. A composite passes one random base with probability at most 1/4.
+bool is_probable_prime(big_integer const &n, std::vector<big_integer> const &bases);
+// The same with the thirteen primes from 2 to 41 as bases, which is exact for n < 3.3 * 10^24
+bool is_probable_prime(big_integer const &n);
+
+#endif // BIGINT_BIGINT_OPTIMIZED_PRIME_H_
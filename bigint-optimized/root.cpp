@@ -0,0 +1,52 @@
+#include "root.h"
+
+#include "power.h"
+
+namespace {
+
+// floor(a^(1/k)) for a >= 0, k >= 2.
+// The root of the leading half of the bits, shifted back, is an upper bound with half of the bits right, so the
+// Newton iterations x -> ((k - 1) x + a / x^(k - 1)) / k that descend from it stop after one or two steps. The
+// recursion halves the length each time, so everything costs a small multiple of the last division.
+big_integer newton_root(big_integer const &a, unsigned k) {
+  size_t const bits = a.bit_length();
+  big_integer x;
+  if (bits <= 2 * k) {
+    x = big_integer(1) << static_cast<int>((bits + k - 1) / k);
+  } else {
+    size_t const shift = bits / (2 * k);
+    x = (newton_root(a >> static_cast<int>(k * shift), k) + 1) << static_cast<int>(shift);
+  }
+  while (true) {
+    big_integer next = (x * (k - 1) + a / pow(x, k - 1)) / k;
+    if (next >= x) {
+      return x;
+    }
+    x.swap(next);
+  }
+}
+
+}
+
+big_integer sqrt(big_integer const &a) {
+  return root(a, 2);
+}
+
+big_integer sqrtrem(big_integer const &a, big_integer &rem) {
+  big_integer res = root(a, 2);
+  rem = a - res * res;
+  return res;
+}
+
+big_integer root(big_integer const &a, unsigned k) {
+  if (k == 0) {
+    throw std::runtime_error("zeroth root");
+  }
+  if (a < 0 && k % 2 == 0) {
+    throw std::runtime_error("even root of negative number");
+  }
+  if (k == 1 || a == 0) {
+    return a;
+  }
+  return a < 0 ? -newton_root(-a, k) : newton_root(a, k);
+}
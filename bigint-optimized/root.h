@@ -0,0 +1,13 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_ROOT_H_
+#define BIGINT_BIGINT_OPTIMIZED_ROOT_H_
+
+#include "big_integer.h"
+
+// floor(sqrt(a)), throws std::runtime_error for a < 0
+big_integer sqrt(big_integer const &a);
+// The same, rem = a - sqrt(a)^2
+big_integer sqrtrem(big_integer const &a, big_integer &rem);
+// The k-th root rounded towards zero, a < 0 only for odd k. Throws std::runtime_error otherwise or for k = 0.
+big_integer root(big_integer const &a, unsigned k);
+
+#endif // BIGINT_BIGINT_OPTIMIZED_ROOT_H_
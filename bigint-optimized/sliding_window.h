@@ -0,0 +1,54 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_SLIDING_WINDOW_H_
+#define BIGINT_BIGINT_OPTIMIZED_SLIDING_WINDOW_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Left-to-right sliding-window exponentiation: x^e for e > 0 of the given bit length, bit(i) being bit i of e.
+// mul(acc, y) sets acc = acc * y and sqr(acc) sets acc = acc^2. The odd powers x, x^3, ..., x^(2^w - 1) are
+// precomputed, then every run of at most w bits starting and ending with a one costs one multiplication.
+template <typename T, typename Bit, typename Mul, typename Sqr>
+T sliding_window_pow(T const &x, size_t bits, Bit bit, Mul mul, Sqr sqr) {
+  size_t const w = bits <= 8 ? 1 : bits <= 24 ? 2 : bits <= 80 ? 3 : bits <= 240 ? 4 : bits <= 672 ? 5 : 6;
+  std::vector<T> odd(size_t(1) << (w - 1), x);
+  if (w > 1) {
+    T x2 = x;
+    sqr(x2);
+    for (size_t i = 1; i < odd.size(); ++i) {
+      odd[i] = odd[i - 1];
+      mul(odd[i], x2);
+    }
+  }
+  T acc = x;
+  bool started = false;
+  for (size_t i = bits; i > 0;) {
+    if (!bit(i - 1)) {
+      sqr(acc);
+      --i;
+      continue;
+    }
+    // the window is bits [low, i - 1], its lowest bit set
+    size_t low = i > w ? i - w : 0;
+    while (!bit(low)) {
+      ++low;
+    }
+    size_t value = 0;
+    for (size_t j = i; j > low; --j) {
+      value = 2 * value + (bit(j - 1) ? 1 : 0);
+    }
+    if (started) {
+      for (size_t j = low; j < i; ++j) {
+        sqr(acc);
+      }
+      mul(acc, odd[value / 2]);
+    } else {
+      acc = odd[value / 2];
+      started = true;
+    }
+    i = low;
+  }
+  return acc;
+}
+
+#endif // BIGINT_BIGINT_OPTIMIZED_SLIDING_WINDOW_H_
@@ -0,0 +1,21 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_STORAGE_H_
+#define BIGINT_BIGINT_OPTIMIZED_STORAGE_H_
+
+// Limb storage of big_integer, selected at build time (see BIGINT_STORAGE in CMakeLists.txt).
+// Every storage provides the interface of buffer.
+
+#if defined(BIGINT_STORAGE_VECTOR)
+#include "vector_storage.h"
+using storage_t = vector_storage;
+#elif defined(BIGINT_STORAGE_FIXED)
+#include "fixed_buffer.h"
+using storage_t = fixed_buffer;
+#elif defined(BIGINT_STORAGE_ARENA)
+#include "arena_storage.h"
+using storage_t = arena_storage;
+#else
+#include "buffer.h"
+using storage_t = buffer;
+#endif
+
+#endif //BIGINT_BIGINT_OPTIMIZED_STORAGE_H_
@@ -0,0 +1,18 @@
+#ifndef BIGINT_BIGINT_OPTIMIZED_VECTOR_STORAGE_H_
+#define BIGINT_BIGINT_OPTIMIZED_VECTOR_STORAGE_H_
+
+#include <vector>
+#include <cstdint>
+
+// Plain std::vector storage: never shared, so every copy is a deep copy
+struct vector_storage : std::vector<uint32_t> {
+  using std::vector<uint32_t>::vector;
+
+  bool exclusive() const {
+    return true;
+  }
+
+  void make_thread_safe() {}
+};
+
+#endif //BIGINT_BIGINT_OPTIMIZED_VECTOR_STORAGE_H_